@@ -0,0 +1,77 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+
+
+// ==== Micro-benchmarks ====
+// Chaque fichier enregistre ses benchs avec NET_BENCH(Nom). Lancement : Bench [filtre]
+
+
+namespace Bench
+{
+    using BenchFunction = void(*)();
+
+    struct Entry
+    {
+        const char* name;
+        BenchFunction function;
+    };
+
+    inline std::vector<Entry>& Registry()
+    {
+        static std::vector<Entry> entries;
+        return entries;
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, BenchFunction function)
+        {
+            Registry().push_back({ name, function });
+        }
+    };
+
+    class Timer
+    {
+    public:
+        Timer() : m_start(std::chrono::steady_clock::now()) {}
+
+        double Seconds() const
+        {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Une ligne de resultat : debit et cout moyen par operation
+    inline void Report(const std::string& label, uint64_t operations, double seconds)
+    {
+        double opsPerSec = seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0;
+        double nsPerOp = operations > 0 ? seconds * 1e9 / static_cast<double>(operations) : 0.0;
+
+        std::cout << "  " << std::left << std::setw(44) << label << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(1) << opsPerSec / 1e6 << " Mops/s"
+                  << std::setw(10) << std::setprecision(1) << nsPerOp << " ns/op\n";
+    }
+
+    // Empeche le compilateur d'eliminer un resultat calcule
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+        const volatile char* bytes = reinterpret_cast<const volatile char*>(&value);
+        (void)*bytes;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+}
+
+#define NET_BENCH(Name) \
+    static void Name(); \
+    static Bench::Registrar Name##_registrar(#Name, &Name); \
+    static void Name()
@@ -0,0 +1,21 @@
+#include "Bench.h"
+
+#include <string>
+
+
+int main(int argc, char** argv)
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+
+    for (const auto& entry : Bench::Registry())
+    {
+        if (!filter.empty() && std::string(entry.name).find(filter) == std::string::npos)
+            continue;
+
+        std::cout << "[" << entry.name << "]\n";
+        entry.function();
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
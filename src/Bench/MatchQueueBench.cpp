@@ -0,0 +1,102 @@
+#include "Bench.h"
+#include "Core/MatchQueue.h"
+
+#include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+
+
+// ==== File de matchmaking : entree/sortie et formation par tick selon la taille de la file ====
+// Temps simule (pas d'horloge) : 20 ticks par seconde, un balayage complet par seconde.
+// Classements tires autour de 1500 (ecart-type 400) sur quelques regions. Pour la formation,
+// la file garde en permanence ses joueurs pre-inscrits, trop ecartes pour se trouver un groupe :
+// chaque balayage les parcourt tous pendant que les arrivees se groupent entre elles.
+
+static constexpr int OperationCount = 200'000;
+static constexpr int TickCount = 400;
+static constexpr int ArrivalsPerTick = 32;
+static constexpr auto TickDuration = std::chrono::milliseconds(50);
+
+static const char* const Regions[] = { "eu", "na", "sa", "asia" };
+
+
+static void RunQueueSize(int queuedCount)
+{
+    std::mt19937 rng(42);
+    std::normal_distribution<double> ratingDist(1500.0, 400.0);
+    std::uniform_int_distribution<int> regionDist(0, 3);
+
+    uint32_t nextIndex = 0;
+    auto insert = [&](MatchQueue& queue, MatchQueue::Clock::time_point now)
+    {
+        queue.Insert({ nextIndex++, 0 }, static_cast<int>(ratingDist(rng)), Regions[regionDist(rng)], now);
+    };
+
+    const std::string suffix = std::to_string(queuedCount) + " en file";
+
+    // --- Entree + sortie, file stable ---
+    {
+        MatchQueue queue;
+        const MatchQueue::Clock::time_point now{};
+        for (int i = 0; i < queuedCount; ++i)
+        {
+            insert(queue, now);
+        }
+
+        Bench::Timer timer;
+        for (int i = 0; i < OperationCount; ++i)
+        {
+            queue.Remove({ nextIndex - static_cast<uint32_t>(queuedCount), 0 });
+            insert(queue, now);
+        }
+        Bench::Report("entree + sortie, " + suffix, OperationCount, timer.Seconds());
+    }
+
+    // --- Formation : arrivees a chaque tick, file pre-remplie ---
+    {
+        MatchmakingConfig config;
+        config.maxSpread = 200;
+        MatchQueue queue(config);
+
+        MatchQueue::Clock::time_point now{};
+        for (int i = 0; i < queuedCount; ++i)
+        {
+            queue.Insert({ nextIndex++, 0 }, 5000 + i * 1000, Regions[i % 4], now);
+        }
+
+        std::vector<MatchGroup> groups;
+        uint64_t formed = 0;
+        double total = 0.0;
+        double worst = 0.0;
+
+        for (int tick = 0; tick < TickCount; ++tick)
+        {
+            now += TickDuration;
+            for (int i = 0; i < ArrivalsPerTick; ++i)
+            {
+                insert(queue, now);
+            }
+
+            groups.clear();
+            Bench::Timer timer;
+            formed += queue.Form(now, groups);
+            const double seconds = timer.Seconds();
+
+            total += seconds;
+            worst = std::max(worst, seconds);
+        }
+
+        Bench::Report("formation, " + suffix, TickCount, total);
+        std::cout << "    " << std::fixed << std::setprecision(1) << total * 1e6 / TickCount << " us/tick, pire tick "
+                  << worst * 1e6 << " us, groupes " << formed << ", restent " << queue.Size() << "\n";
+    }
+}
+
+
+NET_BENCH(MatchQueue)
+{
+    RunQueueSize(1'000);
+    RunQueueSize(10'000);
+    RunQueueSize(50'000);
+}
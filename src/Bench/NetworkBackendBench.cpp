@@ -0,0 +1,210 @@
+#include "Bench.h"
+#include "NetworkCommon.h"
+#include "Platform/IoUringBackend.h"
+
+#include <thread>
+#include <vector>
+
+
+// ==== Reception / emission UDP en boucle locale : appels classiques vs io_uring ====
+// L'emetteur envoie par rafales et attend que le recepteur ait tout lu avant la suivante :
+// aucun datagramme perdu, on mesure bien le cout par paquet cote reception.
+
+static constexpr int DatagramCount = 200'000;
+static constexpr int Burst = 32;
+static constexpr int PayloadSize = 64;
+static constexpr unsigned short BenchPort = 55655;
+static constexpr int SendWaitMs = 50;   // attente max de place dans le tampon d'envoi
+
+
+static sockaddr_in LoopbackAddress()
+{
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(BenchPort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+static SOCKET OpenReceiver()
+{
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = LoopbackAddress();
+
+    if (sock == INVALID_SOCKET || bind(sock, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR)
+    {
+        std::cerr << "Bench: bind impossible sur le port " << BenchPort << "\n";
+        Net::CloseSocket(sock);
+        return INVALID_SOCKET;
+    }
+
+    return sock;
+}
+
+// Rafales de Burst datagrammes, chacune attendant que le recepteur ait rattrape
+static std::thread StartSender(const std::atomic<int>& received)
+{
+    return std::thread([&received]
+    {
+        SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in address = LoopbackAddress();
+        char payload[PayloadSize] = {};
+
+        for (int sent = 0; sent < DatagramCount;)
+        {
+            for (int i = 0; i < Burst && sent < DatagramCount; ++i, ++sent)
+            {
+                sendto(sock, payload, PayloadSize, 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+            }
+
+            while (received.load(std::memory_order_acquire) < sent)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        Net::CloseSocket(sock);
+    });
+}
+
+
+static double RunRecvFrom()
+{
+    SOCKET sock = OpenReceiver();
+    if (sock == INVALID_SOCKET)
+        return 0.0;
+
+    std::atomic<int> received{ 0 };
+    char buffer[MAX_PACKET_SIZE];
+
+    Bench::Timer timer;
+    std::thread sender = StartSender(received);
+
+    while (received.load(std::memory_order_relaxed) < DatagramCount)
+    {
+        sockaddr_in from;
+        SocketLen fromLen = sizeof(from);
+        int n = recvfrom(sock, buffer, MAX_PACKET_SIZE, 0, reinterpret_cast<sockaddr*>(&from), &fromLen);
+        if (n > 0)
+            received.fetch_add(1, std::memory_order_release);
+    }
+
+    double seconds = timer.Seconds();
+    sender.join();
+    Net::CloseSocket(sock);
+    return seconds;
+}
+
+static double RunIoUringReceive()
+{
+    SOCKET sock = OpenReceiver();
+    if (sock == INVALID_SOCKET)
+        return 0.0;
+
+    IoUringBackend uring;
+    if (!uring.Open(sock))
+    {
+        Net::CloseSocket(sock);
+        return 0.0;
+    }
+
+    std::atomic<int> received{ 0 };
+    auto handler = [&received](const char* data, int size, const sockaddr_in&)
+    {
+        Bench::DoNotOptimize(data[size - 1]);
+        received.fetch_add(1, std::memory_order_release);
+    };
+
+    Bench::Timer timer;
+    std::thread sender = StartSender(received);
+
+    while (received.load(std::memory_order_relaxed) < DatagramCount)
+    {
+        uring.Wait(100);
+        uring.ProcessCompletions(handler);
+    }
+
+    double seconds = timer.Seconds();
+    sender.join();
+    uring.Close();
+    Net::CloseSocket(sock);
+    return seconds;
+}
+
+
+// ---- Emission : un sendto par datagramme vs lots de SENDMSG soumis en un io_uring_enter ----
+static double RunSendTo()
+{
+    SOCKET sink = OpenReceiver();
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = LoopbackAddress();
+    char payload[PayloadSize] = {};
+
+    Bench::Timer timer;
+    for (int i = 0; i < DatagramCount; ++i)
+    {
+        sendto(sock, payload, PayloadSize, 0, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    }
+    double seconds = timer.Seconds();
+
+    Net::CloseSocket(sock);
+    Net::CloseSocket(sink);
+    return seconds;
+}
+
+static double RunIoUringSend()
+{
+    SOCKET sink = OpenReceiver();
+    SOCKET sock = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = LoopbackAddress();
+    char payload[PayloadSize] = {};
+
+    IoUringBackend uring;
+    if (!uring.Open(sock))
+    {
+        Net::CloseSocket(sock);
+        Net::CloseSocket(sink);
+        return 0.0;
+    }
+
+    auto ignore = [](const char*, int, const sockaddr_in&) {};
+
+    Bench::Timer timer;
+    for (int sent = 0; sent < DatagramCount;)
+    {
+        while (sent < DatagramCount && uring.QueueSend(payload, PayloadSize, address))
+        {
+            ++sent;
+        }
+
+        uring.SubmitSends(ignore, SendWaitMs);
+    }
+    double seconds = timer.Seconds();
+
+    uring.Close();
+    Net::CloseSocket(sock);
+    Net::CloseSocket(sink);
+    return seconds;
+}
+
+
+NET_BENCH(NetworkBackend)
+{
+    Net::Startup();
+
+    Bench::Report("recv: recvfrom (bloquant)", DatagramCount, RunRecvFrom());
+
+    double uringReceive = RunIoUringReceive();
+    if (uringReceive > 0.0)
+        Bench::Report("recv: io_uring RECVMSG", DatagramCount, uringReceive);
+    else
+        std::cout << "  io_uring indisponible : mesures ignorees\n";
+
+    Bench::Report("send: sendto", DatagramCount, RunSendTo());
+
+    double uringSend = RunIoUringSend();
+    if (uringSend > 0.0)
+        Bench::Report("send: io_uring SENDMSG (lots)", DatagramCount, uringSend);
+
+    Net::Cleanup();
+}
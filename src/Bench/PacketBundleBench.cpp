@@ -0,0 +1,84 @@
+#include "Bench.h"
+#include "NetworkServer.h"
+#include "PacketSystem.h"
+
+#include <vector>
+
+
+// ==== Envoi de fin de tick : un datagramme par paquet vs paquets groupes par destinataire ====
+// Quelques paquets par joueur et par tick (etat, chat systeme, fin de partie...), comme un
+// MiniGameSystem qui termine une manche. Les recepteurs sont des sockets locaux jamais lus.
+
+static constexpr int TickCount = 20'000;
+static constexpr int PeerCount = 8;
+static constexpr int PacketsPerPeer = 4;
+static constexpr unsigned short ServerPort = 55656;
+static constexpr unsigned short FirstPeerPort = 55660;
+
+
+static void RunTicks(const char* label, bool coalesce)
+{
+    NetworkServerConfig config;
+    config.coalesceSends = coalesce;
+
+    NetworkServer server;
+    if (!server.Start(ServerPort, config))
+        return;
+
+    std::vector<SOCKET> sinks;
+    std::vector<sockaddr_in> peers;
+    for (int i = 0; i < PeerCount; ++i)
+    {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<unsigned short>(FirstPeerPort + i));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        SOCKET sink = socket(AF_INET, SOCK_DGRAM, 0);
+        bind(sink, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        sinks.push_back(sink);
+        peers.push_back(address);
+
+        server.SetBundling(address, true);
+    }
+
+    PacketChat chat;
+    chat.Sender = "SYSTEM";
+    chat.Message = "alice gagne la manche !";
+    chat.ChannelName = "System";
+
+    PacketGameEnd gameEnd;
+    PacketPing ping;
+
+    Bench::Timer timer;
+    for (int tick = 0; tick < TickCount; ++tick)
+    {
+        for (const sockaddr_in& peer : peers)
+        {
+            server.SendTo(gameEnd, peer, WireFormat::Compact);
+            server.SendTo(chat, peer, WireFormat::Compact);
+            server.SendTo(chat, peer, WireFormat::Compact);
+            server.SendTo(ping, peer, WireFormat::Compact);
+        }
+
+        server.FlushSends();
+    }
+    double seconds = timer.Seconds();
+
+    NetworkStats stats = server.GetStats();
+    Bench::Report(label, static_cast<uint64_t>(TickCount) * PeerCount * PacketsPerPeer, seconds);
+    std::cout << "    datagrammes " << stats.sentDatagrams << ", groupes " << stats.bundles << " (" << stats.bundledPackets << " paquets), erreurs " << stats.sendErrors << "\n";
+
+    server.Stop();
+    for (SOCKET sink : sinks)
+    {
+        Net::CloseSocket(sink);
+    }
+}
+
+
+NET_BENCH(PacketBundle)
+{
+    RunTicks("un datagramme par paquet", false);
+    RunTicks("paquets groupes par destinataire", true);
+}
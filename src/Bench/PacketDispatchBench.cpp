@@ -0,0 +1,99 @@
+#include "Bench.h"
+#include "PacketDispatcher.h"
+
+#include <map>
+#include <functional>
+#include <vector>
+#include <random>
+
+
+// ==== Distribution par OpCode : std::map + std::function contre table dense ====
+
+static constexpr int PacketCount = 4'000'000;
+static constexpr int DistinctPackets = 1024;   // tampons du pool de 4 Ko : on les recycle
+static constexpr OpCode Registered[] = { OpCode::ConnectionState, OpCode::Chat, OpCode::GameStart, OpCode::GameData, OpCode::Ping, OpCode::PlayerState };
+
+
+static std::vector<GamePacket> MakePackets()
+{
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(std::size(Registered)) - 1);
+
+    std::vector<GamePacket> packets(DistinctPackets);
+    for (auto& packet : packets)
+    {
+        packet << static_cast<int>(Registered[pick(rng)]) << 42;
+    }
+
+    return packets;
+}
+
+
+NET_BENCH(PacketDispatch)
+{
+    std::vector<GamePacket> packets = MakePackets();
+    uint64_t sum = 0;
+
+    // --- Ancienne forme : arbre + appel type-efface ---
+    {
+        std::map<OpCode, std::function<void(GamePacket&)>> handlers;
+        for (OpCode type : Registered)
+        {
+            handlers[type] = [&sum](GamePacket& packet) { int value = 0; packet >> value; sum += value; };
+        }
+
+        Bench::Timer timer;
+        for (int i = 0; i < PacketCount; ++i)
+        {
+            GamePacket& packet = packets[i & (DistinctPackets - 1)];
+            packet.ResetRead();
+
+            int typeInt = 0;
+            packet >> typeInt;
+
+            auto it = handlers.find(static_cast<OpCode>(typeInt));
+            if (it != handlers.end())
+                it->second(packet);
+        }
+        Bench::Report("std::map<OpCode, std::function>", PacketCount, timer.Seconds());
+    }
+
+    // --- Table dense ---
+    {
+        PacketDispatcher<> dispatcher;
+        for (OpCode type : Registered)
+        {
+            dispatcher.On(type, [&sum](GamePacket& packet) { int value = 0; packet >> value; sum += value; });
+        }
+
+        Bench::Timer timer;
+        for (int i = 0; i < PacketCount; ++i)
+        {
+            GamePacket& packet = packets[i & (DistinctPackets - 1)];
+            packet.ResetRead();
+            dispatcher.Dispatch(packet);
+        }
+        Bench::Report("PacketDispatcher (brut)", PacketCount, timer.Seconds());
+    }
+
+    // --- Table dense, handler type (decodage inclus) ---
+    {
+        PacketDispatcher<> dispatcher;
+        for (OpCode type : Registered)
+        {
+            dispatcher.On(type, [&sum](GamePacket& packet) { int value = 0; packet >> value; sum += value; });
+        }
+        dispatcher.On<PacketGameData>([&sum](PacketGameData& packet) { sum += packet.Value; });
+
+        Bench::Timer timer;
+        for (int i = 0; i < PacketCount; ++i)
+        {
+            GamePacket& packet = packets[i & (DistinctPackets - 1)];
+            packet.ResetRead();
+            dispatcher.Dispatch(packet);
+        }
+        Bench::Report("PacketDispatcher (GameData type)", PacketCount, timer.Seconds());
+    }
+
+    Bench::DoNotOptimize(sum);
+}
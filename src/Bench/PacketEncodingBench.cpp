@@ -0,0 +1,198 @@
+#include "Bench.h"
+#include "PacketSystem.h"
+
+#include <vector>
+#include <memory>
+
+
+// ==== Encodage / decodage des paquets ====
+
+static constexpr int MessageCount = 2'000'000;
+
+
+// --- Reference : ancien chemin (appels virtuels, insert par champ, inversion d'octets en boucle) ---
+struct LegacyWriter
+{
+    std::vector<char> bytes;
+
+    template <typename T>
+    void Put(T value)
+    {
+        union
+        {
+            T u;
+            unsigned char u8[sizeof(T)];
+        } source, dest;
+
+        source.u = value;
+        for (size_t k = 0; k < sizeof(T); k++)
+        {
+            dest.u8[k] = source.u8[sizeof(T) - k - 1];
+        }
+
+        const char* ptr = reinterpret_cast<const char*>(&dest.u);
+        bytes.insert(bytes.end(), ptr, ptr + sizeof(T));
+    }
+
+    void Put(const std::string& text)
+    {
+        Put(static_cast<uint16_t>(text.size()));
+        bytes.insert(bytes.end(), text.begin(), text.end());
+    }
+};
+
+struct LegacyPacket
+{
+    virtual ~LegacyPacket() = default;
+
+    void Serialize(LegacyWriter& writer) const
+    {
+        writer.Put(static_cast<int>(GetOpCode()));
+        WritePayload(writer);
+    }
+
+    virtual OpCode GetOpCode() const = 0;
+    virtual void WritePayload(LegacyWriter& writer) const = 0;
+};
+
+struct LegacyChat : LegacyPacket
+{
+    std::string Sender, Message, ChannelName, Target;
+
+    OpCode GetOpCode() const override { return OpCode::Chat; }
+    void WritePayload(LegacyWriter& writer) const override
+    {
+        writer.Put(Sender);
+        writer.Put(Message);
+        writer.Put(ChannelName);
+        writer.Put(Target);
+    }
+};
+
+struct LegacyGameData : LegacyPacket
+{
+    int Value = 0;
+
+    OpCode GetOpCode() const override { return OpCode::GameData; }
+    void WritePayload(LegacyWriter& writer) const override { writer.Put(Value); }
+};
+
+
+template <typename ChatT>
+static void FillChat(ChatT& chat)
+{
+    chat.Sender = "un_pseudo_assez_long";
+    chat.Message = "Un message de chat un peu plus long que le SSO d'une std::string";
+    chat.ChannelName = "Global";
+}
+
+static void RunLegacyEncode(const char* label, const LegacyPacket& packet)
+{
+    LegacyWriter writer;
+    writer.bytes.reserve(PacketBufferPool::BufferCapacity);
+    uint64_t bytes = 0;
+
+    Bench::Timer timer;
+    for (int i = 0; i < MessageCount; ++i)
+    {
+        writer.bytes.clear();
+        packet.Serialize(writer);
+        bytes += writer.bytes.size();
+    }
+    double seconds = timer.Seconds();
+
+    Bench::DoNotOptimize(bytes);
+    Bench::Report(label, MessageCount, seconds);
+}
+
+template <typename PacketT>
+static void RunStaticEncode(const char* label, const PacketT& packet, WireFormat format = WireFormat::Legacy)
+{
+    GamePacket out;
+    uint64_t bytes = 0;
+
+    Bench::Timer timer;
+    for (int i = 0; i < MessageCount; ++i)
+    {
+        out.Clear();
+        packet.Encode(out, format);
+        bytes += out.Size();
+    }
+    double seconds = timer.Seconds();
+
+    Bench::DoNotOptimize(bytes);
+    Bench::Report(label, MessageCount, seconds);
+}
+
+
+// --- Relais serveur : decoder un chat recu puis l'encoder pour la diffusion ---
+template <typename ChatT>
+static void RunRelay(const char* label)
+{
+    PacketChat source;
+    FillChat(source);
+
+    GamePacket received;
+    source.Encode(received);
+
+    GamePacket outgoing;
+    uint64_t bytes = 0;
+
+    Bench::Timer timer;
+    for (int i = 0; i < MessageCount; ++i)
+    {
+        received.ResetRead();
+        int typeInt = 0;
+        received >> typeInt;
+
+        ChatT incoming;
+        incoming.Decode(received);
+
+        ChatT relay;
+        relay.Sender = incoming.Sender;
+        relay.Message = incoming.Message;
+        relay.ChannelName = incoming.ChannelName;
+
+        outgoing.Clear();
+        relay.Encode(outgoing);
+        bytes += outgoing.Size();
+    }
+    double seconds = timer.Seconds();
+
+    Bench::DoNotOptimize(bytes);
+    Bench::Report(label, MessageCount, seconds);
+}
+
+
+NET_BENCH(PacketEncoding)
+{
+    LegacyChat legacyChat;
+    FillChat(legacyChat);
+    PacketChat chat;
+    FillChat(chat);
+
+    LegacyGameData legacyData;
+    legacyData.Value = 42;
+    PacketGameData data;
+    data.Value = 42;
+
+    RunLegacyEncode("Chat, virtuel + insert par champ", legacyChat);
+    RunStaticEncode("Chat, codec statique (Encode)", chat);
+    RunStaticEncode("Chat, codec statique compact", chat, WireFormat::Compact);
+    RunLegacyEncode("GameData, virtuel + insert par champ", legacyData);
+    RunStaticEncode("GameData, codec statique (Encode)", data);
+    RunStaticEncode("GameData, codec statique compact", data, WireFormat::Compact);
+
+    // Taille sur le fil d'un message de chat courant
+    PacketChat shortChat;
+    shortChat.Sender = "alice";
+    shortChat.Message = "salut tout le monde";
+    std::cout << "  Octets par chat (\"" << shortChat.Message << "\") : historique " << shortChat.EncodedSize()
+              << ", compact " << shortChat.EncodedSize(WireFormat::Compact);
+    shortChat.SenderId = 1;
+    shortChat.ChannelId = 1;
+    std::cout << ", compact avec ids " << shortChat.EncodedSize(WireFormat::Compact) << "\n";
+
+    RunRelay<PacketChat>("Relais chat, PacketChat (std::string)");
+    RunRelay<PacketChatView>("Relais chat, PacketChatView (string_view)");
+}
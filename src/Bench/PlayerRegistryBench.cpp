@@ -0,0 +1,130 @@
+#include "Bench.h"
+#include "Core/PlayerRegistry.h"
+
+#include <vector>
+#include <string>
+#include <random>
+
+
+// ==== Recherche d'un joueur par adresse / pseudo selon le nombre de joueurs ====
+// Reference : le parcours lineaire que faisait GameServer::GetPlayerByAddr.
+
+static constexpr int LookupCount = 1'000'000;
+
+
+static sockaddr_in MakeAddress(int i)
+{
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(0x0A000000u + static_cast<uint32_t>(i / 4));
+    address.sin_port = htons(static_cast<unsigned short>(50000 + i % 4));
+    return address;
+}
+
+static PlayerInfo* LinearFind(std::vector<PlayerInfo>& players, const sockaddr_in& addr)
+{
+    for (auto& p : players)
+    {
+        if (p.address.sin_addr.s_addr == addr.sin_addr.s_addr && p.address.sin_port == addr.sin_port)
+            return &p;
+    }
+
+    return nullptr;
+}
+
+static void RunPlayerCount(int playerCount)
+{
+    std::vector<PlayerInfo> linear;
+    PlayerRegistry registry;
+
+    for (int i = 0; i < playerCount; ++i)
+    {
+        PlayerInfo p;
+        p.address = MakeAddress(i);
+        p.pseudo = "player" + std::to_string(i);
+
+        linear.push_back(p);
+        registry.Add(p);
+    }
+
+    // Meme suite de joueurs tires au hasard pour les trois variantes
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, playerCount - 1);
+
+    std::vector<sockaddr_in> addresses(LookupCount);
+    std::vector<std::string> pseudos(LookupCount);
+    for (int i = 0; i < LookupCount; ++i)
+    {
+        int index = pick(rng);
+        addresses[i] = MakeAddress(index);
+        pseudos[i] = "player" + std::to_string(index);
+    }
+
+    const std::string suffix = std::to_string(playerCount) + " joueurs";
+
+    // Le parcours lineaire devient tres lent : on le limite pour les grands effectifs
+    int linearLookups = playerCount > 4096 ? LookupCount / 100 : LookupCount;
+    {
+        Bench::Timer timer;
+        for (int i = 0; i < linearLookups; ++i)
+        {
+            Bench::DoNotOptimize(LinearFind(linear, addresses[i]));
+        }
+        Bench::Report("adresse, parcours lineaire, " + suffix, linearLookups, timer.Seconds());
+    }
+
+    {
+        Bench::Timer timer;
+        for (int i = 0; i < LookupCount; ++i)
+        {
+            Bench::DoNotOptimize(registry.Find(addresses[i]));
+        }
+        Bench::Report("adresse, PlayerRegistry, " + suffix, LookupCount, timer.Seconds());
+    }
+
+    {
+        Bench::Timer timer;
+        for (int i = 0; i < LookupCount; ++i)
+        {
+            Bench::DoNotOptimize(registry.FindByPseudo(pseudos[i]));
+        }
+        Bench::Report("pseudo, PlayerRegistry, " + suffix, LookupCount, timer.Seconds());
+    }
+
+    std::vector<PlayerHandle> handles;
+    for (const auto& p : registry)
+    {
+        handles.push_back(p.handle);
+    }
+
+    {
+        Bench::Timer timer;
+        for (int i = 0; i < LookupCount; ++i)
+        {
+            Bench::DoNotOptimize(registry.Get(handles[i % handles.size()]));
+        }
+        Bench::Report("handle, PlayerRegistry, " + suffix, LookupCount, timer.Seconds());
+    }
+
+    // Depart puis retour d'un joueur au hasard : retrait + insertion, index compris
+    {
+        Bench::Timer timer;
+        for (int i = 0; i < LookupCount; ++i)
+        {
+            PlayerInfo* p = registry.Find(addresses[i]);
+            PlayerInfo copy = *p;
+            registry.Remove(p->handle);
+            registry.Add(copy);
+        }
+        Bench::Report("retrait + ajout, PlayerRegistry, " + suffix, LookupCount, timer.Seconds());
+    }
+}
+
+
+NET_BENCH(PlayerRegistry)
+{
+    for (int playerCount : { 16, 256, 4096, 32768 })
+    {
+        RunPlayerCount(playerCount);
+    }
+}
@@ -0,0 +1,54 @@
+#include "Bench.h"
+#include "RateLimiter.h"
+
+#include <vector>
+#include <random>
+
+
+// ==== Cout de RateLimiter::Allow selon le nombre de sources actives ====
+
+static constexpr int CheckCount = 4'000'000;
+
+
+static void RunSourceCount(int sourceCount)
+{
+    RateLimitConfig config;
+    config.trackedSources = 4096;
+    RateLimiter limiter(config);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, sourceCount - 1);
+    std::uniform_int_distribution<int> opcode(0, 9);
+
+    std::vector<sockaddr_in> sources(CheckCount);
+    std::vector<int> opcodes(CheckCount);
+    for (int i = 0; i < CheckCount; ++i)
+    {
+        int index = pick(rng);
+        sources[i] = {};
+        sources[i].sin_family = AF_INET;
+        sources[i].sin_addr.s_addr = htonl(0x0A000000u + static_cast<uint32_t>(index));
+        sources[i].sin_port = htons(static_cast<unsigned short>(40000 + index % 1000));
+        opcodes[i] = opcode(rng);
+    }
+
+    int allowed = 0;
+    Bench::Timer timer;
+    for (int i = 0; i < CheckCount; ++i)
+    {
+        allowed += limiter.Allow(sources[i], opcodes[i]) ? 1 : 0;
+    }
+    double seconds = timer.Seconds();
+
+    Bench::DoNotOptimize(allowed);
+    Bench::Report("Allow, " + std::to_string(sourceCount) + " sources", CheckCount, seconds);
+}
+
+
+NET_BENCH(RateLimiter)
+{
+    for (int sourceCount : { 16, 1024, 4096, 65536 })
+    {
+        RunSourceCount(sourceCount);
+    }
+}
@@ -0,0 +1,81 @@
+#include "Bench.h"
+#include "ReliableEndpoint.h"
+
+#include <vector>
+#include <random>
+
+
+// ==== Couche fiable : debit d'un canal entre deux extremites, lien simule avec pertes ====
+
+static constexpr int MessageCount = 200'000;
+static constexpr auto TickStep = std::chrono::milliseconds(5);
+
+
+static void RunLink(const char* label, int lossPercent)
+{
+    ReliableEndpoint sender;
+    ReliableEndpoint receiver;
+    std::mt19937 rng(11);
+
+    std::vector<GamePacket> toReceiver;
+    std::vector<GamePacket> toSender;
+    auto newToReceiver = [&toReceiver] { return &toReceiver.emplace_back(); };
+    auto newToSender = [&toSender] { return &toSender.emplace_back(); };
+
+    const char payload[24] = "un message de chat fiab";
+    auto now = ReliableEndpoint::Clock::now();
+    int queued = 0;
+    int delivered = 0;
+    uint64_t wireBytes = 0;
+
+    Bench::Timer timer;
+    while (delivered < MessageCount)
+    {
+        now += TickStep;
+
+        // Au plus une fenetre par tick : la file du canal reste sous MaxQueued
+        for (int i = 0; i < ReliableEndpoint::MaxInFlight && queued < MessageCount; ++i)
+        {
+            if (!sender.Send(0, payload, sizeof(payload)))
+                break;
+            ++queued;
+        }
+
+        sender.Service(now, newToReceiver);
+        receiver.Service(now, newToSender);
+
+        for (GamePacket& frame : toReceiver)
+        {
+            wireBytes += frame.Size();
+            if (static_cast<int>(rng() % 100) < lossPercent)
+                continue;
+
+            receiver.Receive(frame.Data(), static_cast<size_t>(frame.Size()), now, [&delivered](GamePacket&) { ++delivered; });
+        }
+
+        for (GamePacket& frame : toSender)
+        {
+            if (static_cast<int>(rng() % 100) < lossPercent)
+                continue;
+
+            sender.Receive(frame.Data(), static_cast<size_t>(frame.Size()), now, [](GamePacket&) {});
+        }
+
+        toReceiver.clear();
+        toSender.clear();
+    }
+    double seconds = timer.Seconds();
+
+    Bench::DoNotOptimize(wireBytes);
+    Bench::Report(label, MessageCount, seconds);
+    std::cout << "  Retransmissions : " << sender.GetStats().retransmits << ", octets sur le fil par message : "
+              << static_cast<double>(wireBytes) / MessageCount << " (charge utile " << sizeof(payload) << ")\n";
+}
+
+
+NET_BENCH(ReliableLink)
+{
+    RunLink("Canal fiable, sans perte", 0);
+    RunLink("Canal fiable, 5% de pertes", 5);
+    RunLink("Canal fiable, 20% de pertes", 20);
+}
@@ -0,0 +1,144 @@
+#include "Bench.h"
+#include "RingBuffer.h"
+
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+
+
+// Charge utile de la taille d'un ReceivedPacket (sans l'allocation du GamePacket)
+struct BenchItem
+{
+    uint64_t sequence = 0;
+    char payload[56] = {};
+};
+
+static constexpr uint64_t ItemsPerProducer = 2'000'000;
+
+
+// ---- Reference : std::queue + mutex, le consommateur echange la file a chaque poll ----
+static double RunMutexQueue(int producers)
+{
+    std::mutex mutex;
+    std::queue<BenchItem> queue;
+    std::atomic<int> running{ producers };
+
+    Bench::Timer timer;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&]
+        {
+            for (uint64_t i = 0; i < ItemsPerProducer; ++i)
+            {
+                BenchItem item;
+                item.sequence = i;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push(item);
+            }
+            running.fetch_sub(1);
+        });
+    }
+
+    uint64_t consumed = 0;
+    uint64_t expected = ItemsPerProducer * producers;
+    while (consumed < expected)
+    {
+        std::queue<BenchItem> temp;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::swap(temp, queue);
+        }
+
+        while (!temp.empty())
+        {
+            Bench::DoNotOptimize(temp.front().sequence);
+            temp.pop();
+            ++consumed;
+        }
+
+        if (consumed < expected)
+            std::this_thread::yield();
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    return timer.Seconds();
+}
+
+
+// ---- Une SpscRing par producteur, relevees a tour de role : la fusion des shards de reception ----
+static double RunRings(int producers)
+{
+    std::vector<std::unique_ptr<SpscRing<BenchItem>>> rings;
+    for (int p = 0; p < producers; ++p)
+    {
+        rings.push_back(std::make_unique<SpscRing<BenchItem>>(4096));
+    }
+
+    Bench::Timer timer;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p]
+        {
+            SpscRing<BenchItem>& ring = *rings[p];
+            for (uint64_t i = 0; i < ItemsPerProducer; ++i)
+            {
+                BenchItem item;
+                item.sequence = i;
+
+                // Contre-pression : on attend que le consommateur libere de la place
+                while (!ring.TryPush(std::move(item)))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint64_t consumed = 0;
+    uint64_t expected = ItemsPerProducer * producers;
+    BenchItem item;
+    while (consumed < expected)
+    {
+        bool any = false;
+        for (auto& ring : rings)
+        {
+            while (ring->TryPop(item))
+            {
+                Bench::DoNotOptimize(item.sequence);
+                ++consumed;
+                any = true;
+            }
+        }
+
+        if (!any)
+            std::this_thread::yield();
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    return timer.Seconds();
+}
+
+
+NET_BENCH(RingBuffer)
+{
+    Bench::Report("queue+mutex, 1 producer", ItemsPerProducer, RunMutexQueue(1));
+    Bench::Report("SpscRing, 1 producer", ItemsPerProducer, RunRings(1));
+
+    Bench::Report("queue+mutex, 4 producers", ItemsPerProducer * 4, RunMutexQueue(4));
+    Bench::Report("SpscRing x4, polled, 4 producers", ItemsPerProducer * 4, RunRings(4));
+}
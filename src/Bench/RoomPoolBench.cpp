@@ -0,0 +1,95 @@
+#include "Bench.h"
+#include "Systems/RoomPool.h"
+
+#include <string>
+#include <thread>
+
+
+// ==== Salles de jeu : debit de propositions selon le nombre de workers ====
+// Le thread de jeu route des propositions (Guess) vers des salles en cours de manche, puis
+// recupere les reponses encodees comme MiniGameSystem::Update. Une proposition = une reponse ;
+// chaque tick attend ses reponses avant le suivant (pas de file saturee, pas d'abandon).
+
+static constexpr int RoomCount = 64;
+static constexpr int MembersPerRoom = 4;
+static constexpr int EventsPerTick = 2048;
+static constexpr int TickCount = 500;
+
+
+static void RunRooms(int workerCount)
+{
+    RoomPool pool(workerCount, [] {});
+
+    // Les salles annoncent chaque manche sur la sortie standard
+    std::streambuf* output = std::cout.rdbuf(nullptr);
+
+    for (int room = 1; room <= RoomCount; ++room)
+    {
+        pool.Open(static_cast<uint32_t>(room), 0, "Salle#" + std::to_string(room));
+
+        for (int i = 0; i < MembersPerRoom; ++i)
+        {
+            RoomEvent join;
+            join.type = RoomEvent::Type::Join;
+            join.roomId = static_cast<uint32_t>(room);
+            join.member.handle = { static_cast<uint32_t>(room * MembersPerRoom + i), 0 };
+            join.member.pseudo = "joueur" + std::to_string(i);
+            join.member.wireFormat = WireFormat::Compact;
+            pool.Post(std::move(join));
+        }
+
+        RoomEvent start;
+        start.type = RoomEvent::Type::Start;
+        start.roomId = static_cast<uint32_t>(room);
+        pool.Post(std::move(start));
+    }
+    pool.Flush();
+
+    // Le depart de chaque manche part a tous ses membres
+    uint64_t expected = static_cast<uint64_t>(RoomCount) * MembersPerRoom;
+    uint64_t received = 0;
+    auto drain = [&received](RoomOutput&) { ++received; };
+
+    while (received < expected)
+    {
+        pool.Drain(drain);
+        std::this_thread::yield();
+    }
+    received = 0;
+    std::cout.rdbuf(output);
+
+    Bench::Timer timer;
+    uint64_t next = 0;
+    for (int tick = 0; tick < TickCount; ++tick)
+    {
+        for (int i = 0; i < EventsPerTick; ++i, ++next)
+        {
+            RoomEvent guess;
+            guess.type = RoomEvent::Type::Guess;
+            guess.roomId = static_cast<uint32_t>(next % RoomCount) + 1;
+            guess.member.handle = { guess.roomId * MembersPerRoom + static_cast<uint32_t>(next / RoomCount % MembersPerRoom), 0 };
+            guess.value = -1;
+            pool.Post(std::move(guess));
+        }
+
+        pool.Flush();
+
+        while (received < next - pool.GetDroppedEvents())
+        {
+            pool.Drain(drain);
+            std::this_thread::yield();
+        }
+    }
+    double seconds = timer.Seconds();
+
+    Bench::Report(std::to_string(workerCount) + " worker(s)", received, seconds);
+    std::cout << "    abandonnes " << pool.GetDroppedEvents() << "\n";
+}
+
+
+NET_BENCH(RoomPool)
+{
+    RunRooms(1);
+    RunRooms(2);
+    RunRooms(4);
+}
@@ -34,11 +34,8 @@ GameClient::~GameClient()
 void GameClient::SetupNetworkHandlers()
 {    
     // GAME DATA (PLUS / MOINS)
-    m_network.OnPacket(OpCode::GameData, [this](GamePacket& rawPkt) 
+    m_network.OnPacket<PacketGameData>([this](PacketGameData& pkt) 
     {
-        PacketGameData pkt;
-        pkt.Deserialize(rawPkt);
-        
         if (pkt.Value == 1) 
         {
             m_serverMessage = "C'est PLUS (+)"; 
@@ -52,32 +49,25 @@ void GameClient::SetupNetworkHandlers()
     });
 
     // RESULT (VICTOIRE / DEFAITE)
-    m_network.OnPacket(OpCode::GameResult, [this](GamePacket& rawPkt) 
+    m_network.OnPacket<PacketGameResult>([this](PacketGameResult& pkt) 
     {
-        PacketGameResult pkt;
-        pkt.Deserialize(rawPkt);
-
-        m_state = ClientState::Result;
-        m_winnerName = pkt.WinnerName;
-
-        if (pkt.WinnerName == m_pseudoInput)
-        {
-             m_winnerName = "TOI !";
-             SetMuteState(false);
-             SetWindowVolume(100.f);
-             PlaySound(m_soundWin);
-             m_chat.AddMessage("Global", "", "Félicitations, tu as gagné !", MessageType::Success);
-        }
-        else
+        // Gagnant pas encore annonce : le resultat attend le snapshot du roster
+        if (pkt.WinnerId != 0 && !m_playerIds.Find(pkt.WinnerId))
         {
-             PlaySound(m_soundLose);
-             m_chat.AddMessage("Global", "", pkt.WinnerName + " a trouvé le nombre !", MessageType::Info);
+            m_unresolvedResult = std::move(pkt);
+            m_unresolvedResultAt = m_unresolvedClock.getElapsedTime().asSeconds();
+            RequestRosterResync();
+            return;
         }
+
+        m_unresolvedResult.reset();
+        ShowGameResult(std::string(m_playerIds.Resolve(pkt.WinnerId, pkt.WinnerName)));
     });
 
     // GAME START
-    m_network.OnPacket(OpCode::GameStart, [this](GamePacket& rawPkt) 
+    m_network.OnPacket<PacketGameStart>([this](PacketGameStart&) 
     {
+        m_unresolvedResult.reset();
         m_state = ClientState::Game;
         m_serverMessage = "DEVINE LE NOMBRE !";
         m_messageColor = sf::Color::White;
@@ -87,8 +77,9 @@ void GameClient::SetupNetworkHandlers()
     });
 
     // GAME END
-    m_network.OnPacket(OpCode::GameEnd, [this](GamePacket& rawPkt)
+    m_network.OnPacket<PacketGameEnd>([this](PacketGameEnd&)
     {
+         m_unresolvedResult.reset();
          m_state = ClientState::Lobby;
          m_currentNumberChoice = 0;
          m_serverMessage = "Partie terminée par le serveur";
@@ -98,19 +89,37 @@ void GameClient::SetupNetworkHandlers()
     });
 
     // CONNECTION STATE (JOIN / LEAVE)
-    m_network.OnPacket(OpCode::ConnectionState, [this](GamePacket& rawPkt) 
+    m_network.OnPacket<PacketConnectionState>([this](PacketConnectionState& pkt) 
     {
-        PacketConnectionState pkt;
-        pkt.Deserialize(rawPkt);
+        // Diff versionne : doublon ignore, version sautee = diff perdu, on redemande un snapshot
+        if (pkt.RosterVersion != 0)
+        {
+            m_latestRosterDiff = std::max(m_latestRosterDiff, pkt.RosterVersion);
+
+            if (m_rosterVersion != 0)
+            {
+                if (pkt.RosterVersion <= m_rosterVersion)
+                    return;
+
+                if (pkt.RosterVersion == m_rosterVersion + 1)
+                    m_rosterVersion = pkt.RosterVersion;
+                else
+                    RequestRosterResync();
+            }
+        }
 
         if (pkt.IsConnected)
         {
+             m_playerIds.Set(pkt.PlayerId, pkt.Pseudo);
+
              m_serverMessage = pkt.Pseudo + " a rejoint !";
              m_messageColor = sf::Color(100, 255, 200);
              PlaySound(m_soundJoin);
              m_playerNames.push_back(pkt.Pseudo);
              m_playerColors[pkt.Pseudo] = GetColorFromID(pkt.ColorID);
              m_chat.AddMessage("System", pkt.Pseudo, "a rejoint la partie", MessageType::System);
+
+             ReplayUnresolved();
         }
         else
         {
@@ -125,42 +134,65 @@ void GameClient::SetupNetworkHandlers()
                  m_playerNames.erase(it, m_playerNames.end());
              
              m_playerColors.erase(pkt.Pseudo);
+             m_playerIds.Erase(pkt.PlayerId);
         }
     });
 
     // PLAYER LIST
-    m_network.OnPacket(OpCode::PlayerList, [this](GamePacket& rawPkt) 
+    m_network.OnPacket<PacketPlayerList>([this](PacketPlayerList& pkt) 
     {
-        PacketPlayerList pkt;
-        pkt.Deserialize(rawPkt);
+        m_playerIds.Set(pkt.PlayerId, pkt.Pseudo);
         m_playerNames.push_back(pkt.Pseudo);
         m_playerColors[pkt.Pseudo] = GetColorFromID(pkt.ColorID);
+        ReplayUnresolved();
     });
 
-    // CHAT
-    m_network.OnPacket(OpCode::Chat, [this](GamePacket& rawPkt) 
+    // ROSTER SNAPSHOT (parties d'une meme version, dans n'importe quel ordre)
+    m_network.OnPacket<PacketRosterSnapshot>([this](PacketRosterSnapshot& pkt)
     {
-        PacketChat pkt;
-        pkt.Deserialize(rawPkt);
-        if (!pkt.Target.empty())
-        {
-             // Whisper
-             std::string prefix;
-             if (pkt.Sender == m_pseudoInput)
-                prefix = "A " + pkt.Target;
-             else
-                prefix = "De " + pkt.Sender;
+        if (pkt.Version < m_rosterVersion || pkt.Version < m_pendingRosterVersion || pkt.Part >= pkt.PartCount)
+            return;
 
-             m_chat.AddMessage(pkt.ChannelName, prefix, pkt.Message, MessageType::Whisper);
+        if (pkt.Version > m_pendingRosterVersion || m_pendingRosterParts.size() != pkt.PartCount)
+        {
+            m_pendingRosterVersion = pkt.Version;
+            m_pendingRosterParts.assign(pkt.PartCount, false);
+            m_pendingRoster.clear();
         }
-        else
+
+        // Deux resyncs de la meme version : la partie est deja la
+        if (m_pendingRosterParts[pkt.Part])
+            return;
+
+        m_pendingRosterParts[pkt.Part] = true;
+        m_pendingRoster.insert(m_pendingRoster.end(), std::make_move_iterator(pkt.Entries.begin()), std::make_move_iterator(pkt.Entries.end()));
+
+        if (std::find(m_pendingRosterParts.begin(), m_pendingRosterParts.end(), false) == m_pendingRosterParts.end())
+            ApplyRosterSnapshot();
+    });
+
+    // CHAT
+    m_network.OnPacket<PacketChat>([this](PacketChat& pkt) 
+    {
+        // Derriere les messages en attente d'un id : l'ordre du chat est garde
+        if (!m_unresolvedChats.empty() || !ResolveIds(pkt))
         {
-             sf::Color senderColor = sf::Color(130, 180, 255);
-             if (m_playerColors.count(pkt.Sender))
-                 senderColor = m_playerColors[pkt.Sender];
+            if (m_unresolvedChats.size() >= MaxUnresolvedChats)
+                m_unresolvedChats.pop_front();
 
-             m_chat.AddMessage(pkt.ChannelName, pkt.Sender, pkt.Message, MessageType::Normal, senderColor);
+            m_unresolvedChats.push_back({ std::move(pkt), m_unresolvedClock.getElapsedTime().asSeconds() });
+            ReplayUnresolved();
+            return;
         }
+
+        ShowChat(pkt);
+    });
+
+    // CHANNEL INFO
+    m_network.OnPacket<PacketChannelInfo>([this](PacketChannelInfo& pkt)
+    {
+        m_channelIds.Set(pkt.ChannelId, pkt.Name);
+        ReplayUnresolved();
     });
 
     // Envoi du chat
@@ -207,6 +239,10 @@ void GameClient::SetupNetworkHandlers()
         }
 
         pkt.ChannelName = m_chat.GetActiveChannel();
+
+        // Ids connus (serveur compact) : envoyes a la place des noms
+        pkt.ChannelId = static_cast<uint16_t>(m_channelIds.FindId(pkt.ChannelName));
+        pkt.TargetId = static_cast<uint16_t>(m_playerIds.FindId(pkt.Target));
         m_network.Send(pkt);
     });
 }
@@ -249,6 +285,14 @@ void GameClient::Run()
             PacketPing ping;
             m_network.Send(ping);
             m_pingClock.restart();
+
+            // Serveur compact connecte mais snapshot du login perdu : on le redemande
+            if (m_state != ClientState::IpConfig && m_state != ClientState::Login && m_network.GetSendFormat() == WireFormat::Compact && m_rosterVersion == 0)
+                RequestRosterResync();
+
+            // Paquets en attente d'un id : resync redemandee (la precedente a pu se perdre), delais expires
+            if (!m_unresolvedChats.empty() || m_unresolvedResult)
+                ReplayUnresolved();
         }
 
         while (const auto event = m_window.pollEvent())
@@ -311,6 +355,153 @@ void GameClient::Run()
     }
 }
 
+void GameClient::ApplyRosterSnapshot()
+{
+    m_playerNames.clear();
+    m_playerColors.clear();
+    m_playerIds.Clear();
+
+    for (const RosterEntry& entry : m_pendingRoster)
+    {
+        m_playerNames.push_back(entry.Pseudo);
+        m_playerColors[entry.Pseudo] = GetColorFromID(entry.ColorID);
+        m_playerIds.Set(entry.PlayerId, entry.Pseudo);
+    }
+
+    m_rosterVersion = m_pendingRosterVersion;
+    m_pendingRosterParts.clear();
+    m_pendingRoster.clear();
+    m_resyncRequested = false;
+
+    // Un diff plus recent est arrive avant la fin du snapshot : il a ete ecrase
+    if (m_latestRosterDiff > m_rosterVersion)
+        RequestRosterResync();
+
+    ReplayUnresolved();
+}
+
+void GameClient::RequestRosterResync()
+{
+    // Une demande par seconde au plus, le temps que le snapshot arrive
+    if (m_resyncRequested && m_resyncClock.getElapsedTime().asSeconds() < 1.0f)
+        return;
+
+    PacketRosterResync resync;
+    m_network.Send(resync);
+
+    m_resyncRequested = true;
+    m_resyncClock.restart();
+}
+
+void GameClient::RequestChannelResync()
+{
+    // Meme rythme que le roster : une demande par seconde au plus
+    if (m_channelResyncRequested && m_channelResyncClock.getElapsedTime().asSeconds() < 1.0f)
+        return;
+
+    PacketChannelResync resync;
+    m_network.Send(resync);
+
+    m_channelResyncRequested = true;
+    m_channelResyncClock.restart();
+}
+
+bool GameClient::ResolveIds(PacketChat& pkt)
+{
+    const bool playersKnown = (pkt.SenderId == 0 || m_playerIds.Find(pkt.SenderId)) && (pkt.TargetId == 0 || m_playerIds.Find(pkt.TargetId));
+    const bool channelKnown = pkt.ChannelId == 0 || m_channelIds.Find(pkt.ChannelId);
+
+    if (!playersKnown)
+        RequestRosterResync();
+
+    if (!channelKnown)
+        RequestChannelResync();
+
+    if (!playersKnown || !channelKnown)
+        return false;
+
+    // Serveur compact : noms a retrouver depuis les ids
+    pkt.Sender = m_playerIds.Resolve(pkt.SenderId, pkt.Sender);
+    pkt.Target = m_playerIds.Resolve(pkt.TargetId, pkt.Target);
+    pkt.ChannelName = m_channelIds.Resolve(pkt.ChannelId, pkt.ChannelName);
+    return true;
+}
+
+void GameClient::ShowChat(const PacketChat& pkt)
+{
+    if (!pkt.Target.empty())
+    {
+         // Whisper
+         std::string prefix;
+         if (pkt.Sender == m_pseudoInput)
+            prefix = "A " + pkt.Target;
+         else
+            prefix = "De " + pkt.Sender;
+
+         m_chat.AddMessage(pkt.ChannelName, prefix, pkt.Message, MessageType::Whisper);
+    }
+    else
+    {
+         sf::Color senderColor = sf::Color(130, 180, 255);
+         if (m_playerColors.count(pkt.Sender))
+             senderColor = m_playerColors[pkt.Sender];
+
+         m_chat.AddMessage(pkt.ChannelName, pkt.Sender, pkt.Message, MessageType::Normal, senderColor);
+    }
+}
+
+void GameClient::ShowGameResult(const std::string& winnerName)
+{
+    m_state = ClientState::Result;
+    m_winnerName = winnerName;
+
+    if (winnerName == m_pseudoInput)
+    {
+         m_winnerName = "TOI !";
+         SetMuteState(false);
+         SetWindowVolume(100.f);
+         PlaySound(m_soundWin);
+         m_chat.AddMessage("Global", "", "Félicitations, tu as gagné !", MessageType::Success);
+    }
+    else
+    {
+         PlaySound(m_soundLose);
+         m_chat.AddMessage("Global", "", winnerName + " a trouvé le nombre !", MessageType::Info);
+    }
+}
+
+void GameClient::ReplayUnresolved()
+{
+    const float now = m_unresolvedClock.getElapsedTime().asSeconds();
+
+    // Dans l'ordre d'arrivee : un message encore illisible bloque les suivants jusqu'a son delai
+    while (!m_unresolvedChats.empty())
+    {
+        UnresolvedChat& front = m_unresolvedChats.front();
+        if (ResolveIds(front.packet))
+            ShowChat(front.packet);
+        else if (now - front.arrivedAt < UnresolvedTimeout)
+            break;
+
+        m_unresolvedChats.pop_front();
+    }
+
+    if (m_unresolvedResult)
+    {
+        const std::string* winner = m_playerIds.Find(m_unresolvedResult->WinnerId);
+        if (!winner && now - m_unresolvedResultAt < UnresolvedTimeout)
+        {
+            RequestRosterResync();
+            return;
+        }
+
+        // Gagnant parti entre-temps : la manche s'affiche quand meme
+        const std::string winnerName = winner ? *winner : "Un joueur";
+        m_unresolvedResult.reset();
+        ShowGameResult(winnerName);
+    }
+}
+
 void GameClient::UpdateLayout()
 {
     float chatWidth = (std::min)(500.f, static_cast<float>(m_windowSize.x) - 260.f);
@@ -539,8 +730,22 @@ void GameClient::HandleLoginInput(const sf::Event& event)
             PacketConnectionState loginPkt;
             loginPkt.IsConnected = true;
             loginPkt.Pseudo = m_pseudoInput;
+            loginPkt.WireVersion = WIRE_VERSION_FRAGMENT;
+            m_network.ResetReliable();
             m_network.Send(loginPkt);
 
+            m_playerIds.Clear();
+            m_channelIds.Clear();
+            m_rosterVersion = 0;
+            m_latestRosterDiff = 0;
+            m_pendingRosterVersion = 0;
+            m_pendingRosterParts.clear();
+            m_pendingRoster.clear();
+            m_resyncRequested = false;
+            m_channelResyncRequested = false;
+            m_unresolvedChats.clear();
+            m_unresolvedResult.reset();
+
             m_state = ClientState::Lobby;
             m_serverMessage = "Bienvenue " + m_pseudoInput + " !";
             m_playerNames.push_back(m_pseudoInput);
@@ -1,7 +1,8 @@
 #include "NetworkClient.h"
+#include "PacketBundle.h"
 
 
-NetworkClient::NetworkClient() : m_socket(INVALID_SOCKET), m_isConnected(false), m_shouldRun(false), m_serverAddrLen(sizeof(sockaddr_in))
+NetworkClient::NetworkClient() : m_packetQueue(1024), m_droppedPackets(0), m_socket(INVALID_SOCKET), m_isConnected(false), m_shouldRun(false), m_serverAddrLen(sizeof(sockaddr_in))
 {
     memset(&m_serverAddr, 0, sizeof(m_serverAddr));
 }
@@ -18,12 +19,11 @@ bool NetworkClient::Connect(const std::string& address, int port)
     if (address.empty()) 
         return false;
 
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) 
+    if (!Net::Startup()) 
         return false;
 
     addrinfo hints, *res = nullptr;
-    ZeroMemory(&hints, sizeof(hints));
+    memset(&hints, 0, sizeof(hints));
     
     hints.ai_family = AF_INET;
     hints.ai_socktype = SOCK_DGRAM;
@@ -34,7 +34,7 @@ bool NetworkClient::Connect(const std::string& address, int port)
     
     if (result != 0 || res == nullptr) 
     {
-        WSACleanup();
+        Net::Cleanup();
         return false;
     }
 
@@ -42,7 +42,7 @@ bool NetworkClient::Connect(const std::string& address, int port)
     if (m_socket == INVALID_SOCKET)
     {
         freeaddrinfo(res);
-        WSACleanup();
+        Net::Cleanup();
         return false;
     }
     
@@ -53,9 +53,9 @@ bool NetworkClient::Connect(const std::string& address, int port)
 
     if (bind(m_socket, reinterpret_cast<sockaddr*>(&clientAddr), sizeof(clientAddr)) == SOCKET_ERROR)
     {
-        closesocket(m_socket);
+        Net::CloseSocket(m_socket);
         freeaddrinfo(res);
-        WSACleanup();
+        Net::Cleanup();
         return false;
     }
 
@@ -63,8 +63,7 @@ bool NetworkClient::Connect(const std::string& address, int port)
     m_serverAddrLen = static_cast<int>(res->ai_addrlen);
     freeaddrinfo(res);
 
-    DWORD timeout = 5000;
-    setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+    Net::SetReceiveTimeout(m_socket, 5000);
 
     m_isConnected = true;
     m_shouldRun = true;
@@ -80,7 +79,7 @@ void NetworkClient::Disconnect()
     
     if (m_socket != INVALID_SOCKET) 
     {
-        closesocket(m_socket);
+        Net::CloseSocket(m_socket);
         m_socket = INVALID_SOCKET;
     }
 
@@ -89,8 +88,17 @@ void NetworkClient::Disconnect()
         m_receiveThread.join();
     }
     
-    WSACleanup();
+    Net::Cleanup();
     m_isConnected = false;
+    m_sendFormat = WireFormat::Legacy;
+    ResetReliable();
+    m_fragments.Reset();
+}
+
+void NetworkClient::ResetReliable()
+{
+    m_reliable = ReliableEndpoint();
+    m_reliableActive = false;
 }
 
 void NetworkClient::Send(GamePacket& pkt)
@@ -104,69 +112,171 @@ void NetworkClient::Send(GamePacket& pkt)
 void NetworkClient::Send(const IPacket& packet)
 {
     GamePacket rawPacket;
-    packet.Serialize(rawPacket);
-    Send(rawPacket);
+    packet.Serialize(rawPacket, m_sendFormat);
+    Send(rawPacket, packet.GetChannel());
+}
+
+void NetworkClient::Send(GamePacket& packet, ReliableChannel channel)
+{
+    if (channel == ReliableChannel::None || !m_reliableActive)
+    {
+        Send(packet);
+        return;
+    }
+
+    // Part tout de suite : le client n'a pas de fin de tick pour regrouper
+    m_reliable.Send(static_cast<int>(channel), packet.Data(), static_cast<size_t>(packet.Size()));
+    ServiceReliable();
+}
+
+void NetworkClient::ServiceReliable()
+{
+    if (!m_reliableActive || m_reliable.IsIdle())
+        return;
+
+    GamePacket frame;
+    m_reliable.Service(std::chrono::steady_clock::now(), [this, &frame]() -> GamePacket*
+    {
+        // La trame precedente est partie : on reutilise le meme tampon
+        if (frame.Size() > 0)
+            Send(frame);
+
+        frame.Clear();
+        return &frame;
+    });
+
+    if (frame.Size() > 0)
+        Send(frame);
 }
 
 void NetworkClient::OnPacket(OpCode type, PacketHandler handler)
 {
-    m_handlers[type] = handler;
+    m_dispatcher.On(type, std::move(handler));
 }
 
 void NetworkClient::PollEvents()
 {
-    std::lock_guard<std::mutex> lock(m_queueMutex);
-    
-    while (!m_packetQueue.empty())
+    // Les handlers (UI, sons...) tournent hors de tout verrou : la reception continue pendant ce temps
+    GamePacket pkt;
+    size_t budget = m_packetQueue.Capacity();
+
+    while (budget-- > 0 && m_packetQueue.TryPop(pkt))
     {
-        GamePacket& pkt = m_packetQueue.front();
-        
-        int typeInt = 0;
-        pkt >> typeInt; 
-        OpCode type = static_cast<OpCode>(typeInt);
-        
-        auto it = m_handlers.find(type);
-        if (it != m_handlers.end())
+        if (Bundle::IsBundle(pkt.Data(), static_cast<size_t>(pkt.Size())))
         {
-            it->second(pkt);
+            // Entrees traitees dans l'ordre, chacune comme un datagramme recu seul
+            GamePacket entry;
+            Bundle::Unpack(pkt.Data(), static_cast<size_t>(pkt.Size()), [this, &entry](const char* data, size_t size)
+            {
+                entry = GamePacket(data, static_cast<int>(size));
+                HandlePacket(entry);
+            });
+            continue;
         }
-        
-        m_packetQueue.pop();
+
+        HandlePacket(pkt);
+    }
+
+    // Acks des trames recues, retransmissions echues ; messages fragmentes abandonnes
+    ServiceReliable();
+    m_fragments.Expire(std::chrono::steady_clock::now());
+}
+
+void NetworkClient::HandlePacket(GamePacket& pkt)
+{
+    if (Fragment::IsFragment(pkt.Data(), static_cast<size_t>(pkt.Size())))
+    {
+        // Message complet : traite comme un datagramme recu seul (paquet ou trame fiable)
+        m_fragments.Receive(pkt.Data(), static_cast<size_t>(pkt.Size()), std::chrono::steady_clock::now(), [this](GamePacket& message)
+        {
+            const size_t size = static_cast<size_t>(message.Size());
+            if (!Fragment::IsFragment(message.Data(), size) && !Bundle::IsBundle(message.Data(), size))
+                HandlePacket(message);
+        });
+        return;
+    }
+
+    if (pkt.Size() > 0 && static_cast<uint8_t>(pkt.Data()[0]) == RELIABLE_FRAME)
+    {
+        m_reliableActive = true;
+        m_reliable.Receive(pkt.Data(), static_cast<size_t>(pkt.Size()), std::chrono::steady_clock::now(), [this](GamePacket& packet)
+        {
+            m_reliableDelivered.push_back(std::move(packet));
+        });
+
+        for (GamePacket& delivered : m_reliableDelivered)
+        {
+            m_dispatcher.Dispatch(delivered);
+
+            if (delivered.Format() == WireFormat::Compact)
+                m_sendFormat = WireFormat::Compact;
+        }
+        m_reliableDelivered.clear();
+        return;
     }
+
+    m_dispatcher.Dispatch(pkt);
+
+    if (pkt.Format() == WireFormat::Compact)
+        m_sendFormat = WireFormat::Compact;
 }
 
 void NetworkClient::PushPacket(GamePacket pkt)
 {
-    std::scoped_lock lock(m_queueMutex);
-    m_packetQueue.push(pkt);
+    if (!m_packetQueue.TryPush(std::move(pkt)))
+        m_droppedPackets.fetch_add(1, std::memory_order_relaxed);
 }
 
 void NetworkClient::ReceiveLoop()
 {
+    // Winsock definit aussi MSG_TRUNC, mais comme drapeau de sortie de WSARecvMsg : pas pour recvfrom
+#if defined(MSG_TRUNC) && !defined(_WIN32)
+    constexpr int ReceiveFlags = MSG_TRUNC;
+#else
+    constexpr int ReceiveFlags = 0;
+#endif
+
     char buffer[MAX_PACKET_SIZE];
     sockaddr_in from;
-    int fromLen = sizeof(from);
+    SocketLen fromLen = sizeof(from);
     
     while (m_shouldRun)
     {
-        int bytes = recvfrom(m_socket, buffer, MAX_PACKET_SIZE, 0, reinterpret_cast<sockaddr*>(&from), &fromLen);
+        int bytes = recvfrom(m_socket, buffer, MAX_PACKET_SIZE, ReceiveFlags, reinterpret_cast<sockaddr*>(&from), &fromLen);
         
-        if (bytes > 0)
+        if (bytes > MAX_PACKET_SIZE)
         {
-            GamePacket pkt(buffer, bytes);
-            PushPacket(pkt);
+            // Tronque par le noyau (taille reelle rendue grace a MSG_TRUNC) : illisible, abandonne
+            m_truncatedPackets.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (bytes > 0)
+        {
+            PushPacket(GamePacket(buffer, bytes));
         }
         else
         {
+            const int error = Net::LastError();
+
+            // Windows : un datagramme trop gros echoue en WSAEMSGSIZE, sans couper la connexion
+            if (bytes < 0 && Net::IsMessageTooLong(error))
+            {
+                m_truncatedPackets.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
             if (m_shouldRun)
             {
-                std::cerr << "Network Error: " << WSAGetLastError() << std::endl;
+                std::cerr << "Network Error: " << error << std::endl;
                 m_isConnected = false;
                 m_shouldRun = false;
                 
+                PacketConnectionState lost;
+                lost.IsConnected = false;
+                lost.Pseudo = "Serveur";
+
                 GamePacket errorPkt;
-                errorPkt << static_cast<int>(OpCode::ConnectionState) << false << std::string("Serveur");
-                PushPacket(errorPkt);
+                lost.Serialize(errorPkt);
+                PushPacket(std::move(errorPkt));
             }
             break;
         }
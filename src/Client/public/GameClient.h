@@ -1,9 +1,12 @@
 ﻿#pragma once
 #include "NetworkClient.h"
 #include "ChatBox.h"
+#include "NameTable.h"
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <string>
+#include <deque>
+#include <optional>
 
 
 enum class ClientState
@@ -67,6 +70,50 @@ private:
     std::map<std::string, sf::Color> m_playerColors;
     sf::Color GetColorFromID(uint8_t id);
 
+    // Ids de session annonces par le serveur (format compact) -> noms
+    NameTable m_playerIds;
+    NameTable m_channelIds;
+
+    // Roster versionne (format compact) : snapshot en parties, puis arrivees / departs numerotes
+    void ApplyRosterSnapshot();
+    void RequestRosterResync();
+
+    uint32_t m_rosterVersion = 0;           // derniere version appliquee (0 = pas de snapshot)
+    uint32_t m_latestRosterDiff = 0;        // plus haute version vue dans un diff
+    uint32_t m_pendingRosterVersion = 0;    // snapshot en cours de reception
+    std::vector<bool> m_pendingRosterParts;
+    std::vector<RosterEntry> m_pendingRoster;
+    sf::Clock m_resyncClock;
+    bool m_resyncRequested = false;
+
+    // Table des canaux (format compact) : redemandee quand un id de canal inconnu arrive
+    void RequestChannelResync();
+
+    sf::Clock m_channelResyncClock;
+    bool m_channelResyncRequested = false;
+
+    // Paquets portant un id pas encore connu (annonce perdue) : une resync est demandee et ils
+    // attendent, dans l'ordre d'arrivee, que les tables les resolvent. Un message toujours
+    // illisible apres UnresolvedTimeout est abandonne ; un resultat s'affiche sans le pseudo.
+    static constexpr size_t MaxUnresolvedChats = 64;
+    static constexpr float UnresolvedTimeout = 3.0f;
+
+    struct UnresolvedChat
+    {
+        PacketChat packet;
+        float arrivedAt = 0.f;
+    };
+
+    bool ResolveIds(PacketChat& pkt);
+    void ShowChat(const PacketChat& pkt);
+    void ShowGameResult(const std::string& winnerName);
+    void ReplayUnresolved();
+
+    std::deque<UnresolvedChat> m_unresolvedChats;
+    std::optional<PacketGameResult> m_unresolvedResult;
+    float m_unresolvedResultAt = 0.f;
+    sf::Clock m_unresolvedClock;
+
     // Chat
     ChatBox m_chat;
     
@@ -1,18 +1,22 @@
 #pragma once
 #include "PacketSystem.h"
+#include "PacketDispatcher.h"
+#include "ReliableEndpoint.h"
+#include "FragmentAssembler.h"
+#include "RingBuffer.h"
 #include <functional>
-#include <map>
-#include <queue>
-#include <mutex>
 #include <thread>
 #include <atomic>
+#include <vector>
+#include <chrono>
 #include <iostream>
 
 
 class NetworkClient
 {
 public:
-    using PacketHandler = std::function<void(GamePacket&)>;
+    using Dispatcher = PacketDispatcher<>;
+    using PacketHandler = Dispatcher::Handler;
 
     NetworkClient();
     ~NetworkClient();
@@ -24,25 +28,70 @@ public:
     // Packets
     void Send(GamePacket& packet);
     void Send(const IPacket& packet);
+
+    // Paquet concret : encode sans vtable, en un seul redimensionnement
+    template <StaticPacket PacketT>
+    void Send(const PacketT& packet)
+    {
+        GamePacket rawPacket;
+        packet.Encode(rawPacket, m_sendFormat);
+        Send(rawPacket, PacketT::Channel);
+    }
     void PollEvents();
     void OnPacket(OpCode type, PacketHandler handler);
+
+    // Handler type : fn(PacketT&), paquet deja decode
+    template <typename PacketT, typename Fn>
+    void OnPacket(Fn handler) { m_dispatcher.On<PacketT>(std::move(handler)); }
     
     // Disconnection
     bool IsConnected() const { return m_isConnected; }
+    uint64_t GetDroppedPackets() const { return m_droppedPackets; }
+    uint64_t GetTruncatedPackets() const { return m_truncatedPackets; }
+    uint64_t GetUnknownPackets() const { return m_dispatcher.GetUnknownPackets(); }
+    uint64_t GetMalformedPackets() const { return m_dispatcher.GetMalformedPackets(); }
+
+    // Historique jusqu'au premier paquet compact du serveur : il a alors accepte le WireVersion du login
+    WireFormat GetSendFormat() const { return m_sendFormat; }
+
+    // Trames fiables des la premiere recue du serveur (il a accepte WIRE_VERSION_RELIABLE).
+    // A appeler au login : le serveur repart lui aussi d'une extremite neuve.
+    bool IsReliable() const { return m_reliableActive; }
+    void ResetReliable();
+    const ReliableEndpoint& GetReliable() const { return m_reliable; }
+
+    // Messages du serveur plus grands qu'un datagramme, reassembles (WIRE_VERSION_FRAGMENT)
+    const FragmentStats& GetFragmentStats() const { return m_fragments.GetStats(); }
     void SetOnDisconnect(std::function<void(const std::string&)> handler) { m_onDisconnect = handler; }
 
 private:
     void ReceiveLoop();
     void PushPacket(GamePacket pkt);
 
-    // Threading
+    // Un datagramme recu seul, une entree de groupe ou un message reassemble :
+    // fragment, trame fiable ou paquet a distribuer
+    void HandlePacket(GamePacket& pkt);
+
+    // Canal fiable vers un serveur negocie, datagramme brut sinon
+    void Send(GamePacket& packet, ReliableChannel channel);
+    void ServiceReliable();
+
+    // Threading : le thread de reception pousse, PollEvents depile sans verrou
     std::thread m_receiveThread;
-    std::queue<GamePacket> m_packetQueue;
-    std::mutex m_queueMutex;
+    SpscRing<GamePacket> m_packetQueue;
+    std::atomic<uint64_t> m_droppedPackets;
+    std::atomic<uint64_t> m_truncatedPackets{ 0 };
     
     // Handlers
-    std::map<OpCode, PacketHandler> m_handlers;
+    Dispatcher m_dispatcher;
+    WireFormat m_sendFormat = WireFormat::Legacy;
     std::function<void(const std::string&)> m_onDisconnect;
+
+    // Thread principal uniquement (Send, PollEvents)
+    ReliableEndpoint m_reliable;
+    bool m_reliableActive = false;
+    std::vector<GamePacket> m_reliableDelivered;
+    FragmentAssembler m_fragments;
     
     // Socket data
     SOCKET m_socket;
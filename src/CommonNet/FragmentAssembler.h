@@ -0,0 +1,242 @@
+#pragma once
+#include "NetworkCommon.h"
+#include <vector>
+#include <array>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+// ==== Fragment ====
+// [FRAGMENT_FRAME][message u16][index u8][count u8][octets]
+// Un message trop gros pour un datagramme (paquet ou trame fiable, en-tete compris) part en
+// 'count' fragments de MaxChunk octets, le dernier plus court. Chaque fragment tient dans
+// SAFE_DATAGRAM_SIZE : ni fragmentation IP, ni tampon de reception agrandi.
+namespace Fragment
+{
+    constexpr size_t HeaderSize = 1 + 2 + 1 + 1;
+    constexpr size_t MaxChunk = static_cast<size_t>(SAFE_DATAGRAM_SIZE) - HeaderSize;
+
+    // Borne cote emetteur et cote recepteur : au plus MaxFragments fragments par message
+    constexpr size_t MaxMessageSize = 64 * 1024;
+    constexpr size_t MaxFragments = (MaxMessageSize + MaxChunk - 1) / MaxChunk;
+
+    static_assert(MaxFragments < 64, "Le masque des fragments recus tient sur 64 bits.");
+
+    inline bool IsFragment(const char* data, size_t size)
+    {
+        return size > 0 && static_cast<uint8_t>(data[0]) == FRAGMENT_FRAME;
+    }
+
+    inline bool NeedsSplit(size_t size)
+    {
+        return size > static_cast<size_t>(SAFE_DATAGRAM_SIZE);
+    }
+
+    // newFrame() -> GamePacket* vide, a remplir par fragment. false si le message depasse MaxMessageSize.
+    template <typename NewFrameFn>
+    bool Split(const char* data, size_t size, uint16_t messageId, NewFrameFn&& newFrame)
+    {
+        if (size == 0 || size > MaxMessageSize)
+            return false;
+
+        const size_t count = (size + MaxChunk - 1) / MaxChunk;
+        for (size_t index = 0; index < count; ++index)
+        {
+            const size_t offset = index * MaxChunk;
+            const size_t chunk = std::min(MaxChunk, size - offset);
+
+            GamePacket* frame = newFrame();
+            if (!frame)
+                return false;
+
+            char* out = frame->Extend(HeaderSize + chunk);
+            out[0] = static_cast<char>(FRAGMENT_FRAME);
+            out[1] = static_cast<char>(messageId >> 8);
+            out[2] = static_cast<char>(messageId);
+            out[3] = static_cast<char>(index);
+            out[4] = static_cast<char>(count);
+            std::memcpy(out + HeaderSize, data + offset, chunk);
+        }
+
+        return true;
+    }
+}
+
+
+struct FragmentStats
+{
+    uint64_t completed = 0;     // messages reassembles et rendus
+    uint64_t expired = 0;       // messages incomplets abandonnes apres Timeout
+    uint64_t evicted = 0;       // messages incomplets chasses par un plus recent (MaxPartials atteint)
+    uint64_t rejected = 0;      // fragments illisibles ou incoherents avec leur message
+};
+
+
+// ==== Reassemblage des fragments d'un pair ====
+// Memoire bornee : au plus MaxPartials messages en cours, chacun d'au plus MaxMessageSize octets.
+// Un message incomplet est abandonne apres Timeout ; un fragment de trop chasse le plus ancien.
+// Les tampons des messages en cours sont recycles d'un message a l'autre.
+class FragmentAssembler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t MaxPartials = 4;
+    static constexpr size_t RecentCount = 16;
+    static constexpr auto Timeout = std::chrono::seconds(2);
+
+    // deliver(GamePacket& message) une fois le dernier fragment recu. false si le fragment est refuse.
+    template <typename DeliverFn>
+    bool Receive(const char* data, size_t size, Clock::time_point now, DeliverFn&& deliver)
+    {
+        Expire(now);
+
+        if (!Fragment::IsFragment(data, size) || size <= Fragment::HeaderSize)
+            return Reject();
+
+        const uint16_t messageId = static_cast<uint16_t>((static_cast<uint8_t>(data[1]) << 8) | static_cast<uint8_t>(data[2]));
+        const size_t index = static_cast<uint8_t>(data[3]);
+        const size_t count = static_cast<uint8_t>(data[4]);
+        const size_t chunk = size - Fragment::HeaderSize;
+
+        // Tous les fragments font MaxChunk sauf le dernier : l'index donne directement la position
+        const bool last = index + 1 == count;
+        if (count < 2 || count > Fragment::MaxFragments || index >= count || chunk > Fragment::MaxChunk || (!last && chunk != Fragment::MaxChunk))
+            return Reject();
+
+        Partial* partial = Find(messageId);
+        if (partial && partial->count != count)
+            return Reject();
+
+        if (!partial)
+        {
+            // Doublon tardif d'un message deja rendu : ne rouvre pas de message fantome
+            if (IsRecent(messageId))
+                return true;
+
+            partial = &Start(messageId, count, now);
+        }
+
+        const uint64_t bit = uint64_t{ 1 } << index;
+        if (partial->received & bit)
+            return true;
+
+        std::memcpy(partial->bytes.data() + index * Fragment::MaxChunk, data + Fragment::HeaderSize, chunk);
+        partial->received |= bit;
+        if (last)
+            partial->size = index * Fragment::MaxChunk + chunk;
+
+        if (partial->received != (uint64_t{ 1 } << count) - 1)
+            return true;
+
+        GamePacket message(partial->bytes.data(), static_cast<int>(partial->size));
+        partial->active = false;
+        ++m_stats.completed;
+
+        m_recent[m_recentNext] = messageId;
+        m_recentNext = (m_recentNext + 1) % RecentCount;
+        m_recentSize = std::min(m_recentSize + 1, RecentCount);
+
+        deliver(message);
+        return true;
+    }
+
+    // Abandonne les messages incomplets dont le premier fragment date de plus de Timeout
+    void Expire(Clock::time_point now)
+    {
+        for (Partial& partial : m_partials)
+        {
+            if (partial.active && now - partial.started > Timeout)
+            {
+                partial.active = false;
+                ++m_stats.expired;
+            }
+        }
+    }
+
+    void Reset()
+    {
+        for (Partial& partial : m_partials)
+        {
+            partial.active = false;
+        }
+
+        m_recentSize = 0;
+        m_recentNext = 0;
+    }
+
+    const FragmentStats& GetStats() const { return m_stats; }
+
+private:
+    struct Partial
+    {
+        bool active = false;
+        uint16_t messageId = 0;
+        size_t count = 0;
+        size_t size = 0;
+        uint64_t received = 0;
+        Clock::time_point started;
+        std::vector<char> bytes;
+    };
+
+    Partial* Find(uint16_t messageId)
+    {
+        for (Partial& partial : m_partials)
+        {
+            if (partial.active && partial.messageId == messageId)
+                return &partial;
+        }
+        return nullptr;
+    }
+
+    Partial& Start(uint16_t messageId, size_t count, Clock::time_point now)
+    {
+        // Emplacement libre, sinon le message en cours le plus ancien
+        Partial* slot = &m_partials[0];
+        for (Partial& partial : m_partials)
+        {
+            if (!partial.active)
+            {
+                slot = &partial;
+                break;
+            }
+
+            if (partial.started < slot->started)
+                slot = &partial;
+        }
+
+        if (slot->active)
+            ++m_stats.evicted;
+
+        slot->active = true;
+        slot->messageId = messageId;
+        slot->count = count;
+        slot->size = 0;
+        slot->received = 0;
+        slot->started = now;
+        slot->bytes.resize(count * Fragment::MaxChunk);
+        return *slot;
+    }
+
+    bool IsRecent(uint16_t messageId) const
+    {
+        const auto end = m_recent.begin() + static_cast<std::ptrdiff_t>(m_recentSize);
+        return std::find(m_recent.begin(), end, messageId) != end;
+    }
+
+    bool Reject()
+    {
+        ++m_stats.rejected;
+        return false;
+    }
+
+    std::array<Partial, MaxPartials> m_partials;
+
+    // Derniers messages rendus (anneau), pour ignorer leurs fragments en double
+    std::array<uint16_t, RecentCount> m_recent = {};
+    size_t m_recentNext = 0;
+    size_t m_recentSize = 0;
+    FragmentStats m_stats;
+};
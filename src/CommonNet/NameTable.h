@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+
+// ==== Table d'identifiants de session ====
+// Ids numeriques attribues par le serveur (joueurs, canaux), annonces une fois avec leur nom.
+// id -> nom en acces direct (ids denses), nom -> id par hachage. 0 = pas d'identifiant.
+class NameTable
+{
+public:
+    // Borne les ids acceptes : un pair ne peut pas faire grossir la table a volonte
+    static constexpr uint32_t MaxId = 0xFFFF;
+
+    void Set(uint32_t id, std::string_view name)
+    {
+        if (id == 0 || id > MaxId)
+            return;
+
+        Erase(id);
+        if (m_names.size() <= id)
+            m_names.resize(id + 1);
+
+        m_names[id].assign(name);
+        m_ids[m_names[id]] = id;
+    }
+
+    void Erase(uint32_t id)
+    {
+        if (id >= m_names.size() || m_names[id].empty())
+            return;
+
+        auto it = m_ids.find(m_names[id]);
+        if (it != m_ids.end() && it->second == id)
+            m_ids.erase(it);
+
+        m_names[id].clear();
+    }
+
+    void Clear()
+    {
+        m_names.clear();
+        m_ids.clear();
+    }
+
+    // nullptr si l'id est inconnu
+    const std::string* Find(uint32_t id) const
+    {
+        return id < m_names.size() && !m_names[id].empty() ? &m_names[id] : nullptr;
+    }
+
+    // 0 si le nom n'a pas d'id
+    uint32_t FindId(std::string_view name) const
+    {
+        auto it = m_ids.find(name);
+        return it != m_ids.end() ? it->second : 0;
+    }
+
+    // fn(id, nom) pour chaque entree, par id croissant
+    template <typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (uint32_t id = 1; id < m_names.size(); ++id)
+        {
+            if (!m_names[id].empty())
+                fn(id, m_names[id]);
+        }
+    }
+
+    // Nom de l'id s'il est connu, sinon le nom transmis en clair
+    std::string_view Resolve(uint32_t id, std::string_view fallback) const
+    {
+        const std::string* name = Find(id);
+        return name ? std::string_view(*name) : fallback;
+    }
+
+private:
+    struct NameHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, uint32_t, NameHash, std::equal_to<>> m_ids;
+};
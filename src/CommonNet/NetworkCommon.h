@@ -1,18 +1,59 @@
 #pragma once
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include "SocketPlatform.h"
+#include "PacketBufferPool.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstring>
 #include <stdexcept>
 #include <bit>
-
-#pragma comment(lib, "ws2_32.lib")
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
 
 const int PORT = 55555;
 const int MAX_PACKET_SIZE = 4096;
 const int TIMEOUT_SECONDS = 5;
 
+// Charge utile d'un datagramme qui passe sans fragmentation IP sur les chemins courants
+const int SAFE_DATAGRAM_SIZE = 1200;
+
+// Format compact (v1) : premier octet = COMPACT_HEADER | version, puis l'OpCode sur un octet.
+// Un paquet historique commence par son OpCode int big-endian, donc par 0x00.
+const uint8_t WIRE_VERSION = 1;
+const uint8_t COMPACT_HEADER = 0x80;
+const uint8_t COMPACT_VERSION_MASK = 0x0F;
+
+// Niveau annonce au login (PacketConnectionState::WireVersion) par un client qui comprend aussi
+// les trames fiables. L'en-tete compact reste en WIRE_VERSION.
+const uint8_t WIRE_VERSION_RELIABLE = 2;
+
+// Niveau suivant : le client sait aussi depaqueter les datagrammes groupes (voir PacketBundle)
+const uint8_t WIRE_VERSION_BUNDLE = 3;
+
+// Niveau suivant : le client reassemble aussi les fragments (voir FragmentAssembler)
+const uint8_t WIRE_VERSION_FRAGMENT = 4;
+
+// Premier octet d'une trame fiable (voir ReliableEndpoint) : hors des en-tetes historique et compact
+const uint8_t RELIABLE_FRAME = 0xF0;
+
+// Premier octet d'un datagramme groupant plusieurs paquets pour un meme destinataire
+const uint8_t BUNDLE_FRAME = 0xF1;
+
+// Premier octet d'un fragment de message plus grand que SAFE_DATAGRAM_SIZE
+const uint8_t FRAGMENT_FRAME = 0xF2;
+
+enum class WireFormat : uint8_t
+{
+    Legacy = 0,     // OpCode int32, longueurs uint16, champs en taille fixe
+    Compact = 1     // Voir PacketCodec : bits de presence, varints LEB128
+};
+
+constexpr int WireFormatCount = 2;
+
+static_assert(PacketBufferPool::BufferCapacity == MAX_PACKET_SIZE, "Les tampons du pool doivent contenir un datagramme complet.");
+
 enum class PacketType_Legacy : int
 {
     Connect = 0,
@@ -26,79 +67,197 @@ enum class PacketType_Legacy : int
     PlayerList = 8
 };
 
-class GamePacket
+// ==== Ordre des octets ====
+namespace Net
 {
-public:
-    GamePacket() 
+    // Inverse les octets d'un scalaire : une instruction (bswap / rev) pour 2, 4 et 8 octets
+    template <typename T>
+    inline T ByteSwap(T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        if constexpr (sizeof(T) == 1)
+        {
+            return value;
+        }
+        else if constexpr (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+        {
+            using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+
+            Bits bits;
+            std::memcpy(&bits, &value, sizeof(T));
+#if defined(_MSC_VER)
+            if constexpr (sizeof(T) == 2) bits = _byteswap_ushort(bits);
+            else if constexpr (sizeof(T) == 4) bits = _byteswap_ulong(bits);
+            else bits = _byteswap_uint64(bits);
+#else
+            if constexpr (sizeof(T) == 2) bits = __builtin_bswap16(bits);
+            else if constexpr (sizeof(T) == 4) bits = __builtin_bswap32(bits);
+            else bits = __builtin_bswap64(bits);
+#endif
+            std::memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+        else
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (size_t k = 0; k < sizeof(T) / 2; k++)
+            {
+                std::swap(bytes[k], bytes[sizeof(T) - k - 1]);
+            }
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+    }
+
+    // Ordre reseau (big-endian) <-> ordre machine ; symetrique
+    template <typename T>
+    inline T ToNetwork(T value)
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            return ByteSwap(value);
+        else
+            return value;
+    }
+
+    template <typename T>
+    inline T FromNetwork(T value)
     {
-        m_buffer.reserve(512); 
+        return ToNetwork(value);
     }
+}
+
+// Lecture hors limites : paquet tronque ou incoherent (distinct des erreurs de logique).
+// Aussi a l'ecriture d'un champ qui deborde son format historique (chaine de plus de 64 Ko).
+class PacketError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Le tampon est emprunte au PacketBufferPool a la premiere ecriture et rendu
+// automatiquement a la destruction : pas d'allocation par paquet en regime etabli.
+class GamePacket
+{
+public:
+    GamePacket() = default;
 
     GamePacket(const char* rawData, int size)
     {
-        m_buffer.assign(rawData, rawData + size);
+        Buffer().assign(rawData, rawData + size);
         m_readPos = 0;
     }
 
+    GamePacket(const GamePacket& other) : m_readPos(other.m_readPos), m_format(other.m_format)
+    {
+        if (other.m_buffer)
+            Buffer() = *other.m_buffer;
+    }
+
+    GamePacket(GamePacket&& other) noexcept : m_buffer(other.m_buffer), m_readPos(other.m_readPos), m_format(other.m_format)
+    {
+        other.m_buffer = nullptr;
+        other.m_readPos = 0;
+    }
+
+    GamePacket& operator=(const GamePacket& other)
+    {
+        if (this != &other)
+        {
+            if (other.m_buffer)
+                Buffer() = *other.m_buffer;
+            else if (m_buffer)
+                m_buffer->clear();
+
+            m_readPos = other.m_readPos;
+            m_format = other.m_format;
+        }
+        return *this;
+    }
+
+    GamePacket& operator=(GamePacket&& other) noexcept
+    {
+        if (this != &other)
+        {
+            PacketBufferPool::Release(m_buffer);
+            m_buffer = other.m_buffer;
+            m_readPos = other.m_readPos;
+            m_format = other.m_format;
+
+            other.m_buffer = nullptr;
+            other.m_readPos = 0;
+        }
+        return *this;
+    }
+
+    ~GamePacket()
+    {
+        PacketBufferPool::Release(m_buffer);
+    }
+
     // --- ÉCRITURE (SEND) ---
     template<typename T>
     GamePacket& operator<<(const T& data)
     {
         static_assert(std::is_trivially_copyable_v<T>, "Erreur : Impossible de serialiser un objet complexe (contient pointeurs ou vtable).");
-        T networkData = data;
-        
-        if constexpr (std::endian::native == std::endian::little)
-            networkData = SwapEndian(data);
-
-        const char* ptr = reinterpret_cast<const char*>(&networkData);
-        m_buffer.insert(m_buffer.end(), ptr, ptr + sizeof(T));
+        T networkData = Net::ToNetwork(data);
+        std::memcpy(Extend(sizeof(T)), &networkData, sizeof(T));
         return *this;
     }
 
-    GamePacket& operator<<(const std::string& data)
+    GamePacket& operator<<(std::string_view data)
     {
+        if (data.size() > UINT16_MAX)
+            throw PacketError("[GamePacket] Overflow: Chaine trop longue pour une longueur uint16.");
+
         uint16_t size = static_cast<uint16_t>(data.size());
         *this << size;
         
-        m_buffer.insert(m_buffer.end(), data.begin(), data.end());
+        if (size > 0)
+            std::memcpy(Extend(size), data.data(), size);
         return *this;
     }
 
+    GamePacket& operator<<(const std::string& data)
+    {
+        return *this << std::string_view(data);
+    }
+
     // --- LECTURE (RECEIVE) ---
     template<typename T>
     GamePacket& operator>>(T& data)
     {
         static_assert(std::is_trivially_copyable_v<T>, "Erreur : Type non-POD.");
 
-        if (m_readPos + sizeof(T) > m_buffer.size())
-            throw std::runtime_error("[GamePacket] Buffer Underflow: Tentative de lecture hors limites.");
+        if (m_readPos + sizeof(T) > static_cast<size_t>(Size()))
+            throw PacketError("[GamePacket] Buffer Underflow: Tentative de lecture hors limites.");
 
         T temp;
-        std::memcpy(&temp, &m_buffer[m_readPos], sizeof(T));
-        
-        if constexpr (std::endian::native == std::endian::little)
-        {
-            data = SwapEndian(temp);
-        }
-        else 
-        {
-            data = temp;
-        }
+        std::memcpy(&temp, m_buffer->data() + m_readPos, sizeof(T));
+        data = Net::FromNetwork(temp);
 
         m_readPos += sizeof(T);
         return *this;
     }
 
-    GamePacket& operator>>(std::string& data)
+    // Vue sur le tampon du paquet, sans copie : valide tant que le paquet vit et n'est pas modifie
+    // (toute la duree d'un handler de reception)
+    GamePacket& operator>>(std::string_view& data)
     {
         uint16_t size = 0;
         *this >> size;
         
-        if (m_readPos + size > m_buffer.size()) 
-            throw std::runtime_error("[GamePacket] Buffer Underflow: String trop longue.");
+        data = ReadBytes(size);
+        return *this;
+    }
 
-        data.assign(&m_buffer[m_readPos], size);
-        m_readPos += size;
+    GamePacket& operator>>(std::string& data)
+    {
+        std::string_view view;
+        *this >> view;
+
+        data.assign(view);
         return *this;
     }
 
@@ -106,14 +265,44 @@ public:
     // Accesseurs
     const char* Data() const
     {
-        return m_buffer.data();
+        return m_buffer ? m_buffer->data() : nullptr;
     }
     
     int Size() const
     {
-        return static_cast<int>(m_buffer.size());
+        return m_buffer ? static_cast<int>(m_buffer->size()) : 0;
     }
     
+    // 'size' octets bruts a la position de lecture, sans copie (meme duree de vie que >> string_view)
+    std::string_view ReadBytes(size_t size)
+    {
+        if (m_readPos + size > static_cast<size_t>(Size())) 
+            throw PacketError("[GamePacket] Buffer Underflow: String trop longue.");
+
+        std::string_view bytes(m_buffer->data() + m_readPos, size);
+        m_readPos += size;
+        return bytes;
+    }
+
+    size_t Remaining() const
+    {
+        return static_cast<size_t>(Size()) - m_readPos;
+    }
+
+    // Format du paquet recu, fixe par la distribution d'apres l'en-tete : Decode() s'y conforme
+    WireFormat Format() const { return m_format; }
+    void SetFormat(WireFormat format) { m_format = format; }
+
+    // Agrandit le paquet de 'bytes' octets et rend la zone ajoutee, a remplir par l'appelant.
+    // Un seul redimensionnement quand la taille encodee est connue d'avance.
+    char* Extend(size_t bytes)
+    {
+        PacketBufferPool::Buffer& buffer = Buffer();
+        const size_t offset = buffer.size();
+        buffer.resize(offset + bytes);
+        return buffer.data() + offset;
+    }
+
     void ResetRead()
     {
         m_readPos = 0;
@@ -121,31 +310,23 @@ public:
     
     void Clear()
     {
-        m_buffer.clear(); m_readPos = 0;
+        if (m_buffer)
+            m_buffer->clear();
+        
+        m_readPos = 0;
+        m_format = WireFormat::Legacy;
     }
 
 private:
-    std::vector<char> m_buffer;
-    size_t m_readPos = 0;
-    
-    template <typename T>
-    T SwapEndian(T u)
+    PacketBufferPool::Buffer& Buffer()
     {
-        static_assert(std::is_trivially_copyable_v<T>);
-        union
-        {
-            T u; 
-            unsigned char u8[sizeof(T)];
-        }
-        
-        source, dest;
-        source.u = u;
-        
-        for (size_t k = 0; k < sizeof(T); k++)
-        {
-            dest.u8[k] = source.u8[sizeof(T) - k - 1];
-        }
-        
-        return dest.u;
+        if (!m_buffer)
+            m_buffer = PacketBufferPool::Acquire();
+
+        return *m_buffer;
     }
+
+    PacketBufferPool::Buffer* m_buffer = nullptr;
+    size_t m_readPos = 0;
+    WireFormat m_format = WireFormat::Legacy;
 };
\ No newline at end of file
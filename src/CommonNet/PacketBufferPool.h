@@ -0,0 +1,138 @@
+#pragma once
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+
+// ==== Pool de tampons de paquets ====
+// Tampons recycles pour GamePacket : une fois le pool chaud, plus aucune allocation par paquet.
+// Chaque thread garde un petit cache local et n'echange avec le pool global que par lots,
+// ce qui amortit le verrou quand un thread acquiert (reception) et un autre rend (jeu).
+class PacketBufferPool
+{
+public:
+    using Buffer = std::vector<char>;
+
+    static constexpr size_t BufferCapacity = 4096;   // = MAX_PACKET_SIZE
+    static constexpr size_t LocalCacheSize = 64;
+    static constexpr size_t TransferBatch = 32;
+    static constexpr size_t MaxPooledBuffers = 16384;
+
+    // Tampon vide avec au moins BufferCapacity octets reserves
+    static Buffer* Acquire()
+    {
+        LocalCache& local = Local();
+        if (local.buffers.empty())
+            Refill(local);
+
+        if (!local.buffers.empty())
+        {
+            Buffer* buffer = local.buffers.back();
+            local.buffers.pop_back();
+            return buffer;
+        }
+
+        Global().allocations.fetch_add(1, std::memory_order_relaxed);
+
+        Buffer* buffer = new Buffer();
+        buffer->reserve(BufferCapacity);
+        return buffer;
+    }
+
+    static void Release(Buffer* buffer)
+    {
+        if (buffer == nullptr)
+            return;
+
+        // Un tampon qui a beaucoup grossi (gros message) n'est pas garde
+        if (buffer->capacity() > BufferCapacity * 4)
+        {
+            delete buffer;
+            return;
+        }
+
+        buffer->clear();
+
+        LocalCache& local = Local();
+        local.buffers.push_back(buffer);
+
+        if (local.buffers.size() >= LocalCacheSize)
+            Spill(local, TransferBatch);
+    }
+
+    // Nombre de tampons alloues depuis le demarrage (doit plafonner en regime etabli)
+    static uint64_t Allocations()
+    {
+        return Global().allocations.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct GlobalPool
+    {
+        std::mutex mutex;
+        std::vector<Buffer*> free;
+        std::atomic<uint64_t> allocations{ 0 };
+
+        GlobalPool()
+        {
+            free.reserve(MaxPooledBuffers);
+        }
+    };
+
+    struct LocalCache
+    {
+        std::vector<Buffer*> buffers;
+
+        LocalCache()
+        {
+            buffers.reserve(LocalCacheSize);
+        }
+
+        ~LocalCache()
+        {
+            Spill(*this, buffers.size());
+        }
+    };
+
+    static GlobalPool& Global()
+    {
+        // Jamais detruit : des threads peuvent rendre leurs tampons pendant l'arret
+        static GlobalPool* pool = new GlobalPool();
+        return *pool;
+    }
+
+    static LocalCache& Local()
+    {
+        thread_local LocalCache cache;
+        return cache;
+    }
+
+    static void Refill(LocalCache& local)
+    {
+        GlobalPool& global = Global();
+        std::lock_guard<std::mutex> lock(global.mutex);
+
+        size_t count = global.free.size() < TransferBatch ? global.free.size() : TransferBatch;
+        local.buffers.insert(local.buffers.end(), global.free.end() - count, global.free.end());
+        global.free.resize(global.free.size() - count);
+    }
+
+    static void Spill(LocalCache& local, size_t count)
+    {
+        GlobalPool& global = Global();
+        std::lock_guard<std::mutex> lock(global.mutex);
+
+        for (size_t i = 0; i < count && !local.buffers.empty(); ++i)
+        {
+            Buffer* buffer = local.buffers.back();
+            local.buffers.pop_back();
+
+            if (global.free.size() < MaxPooledBuffers)
+                global.free.push_back(buffer);
+            else
+                delete buffer;
+        }
+    }
+};
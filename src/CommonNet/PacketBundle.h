@@ -0,0 +1,96 @@
+#pragma once
+#include "NetworkCommon.h"
+#include "PacketSystem.h"
+#include <cstdint>
+#include <cstring>
+
+
+// ==== Datagramme groupe ====
+// [BUNDLE_FRAME][taille varint][paquet][taille varint][paquet]...
+// Plusieurs paquets encodes pour un meme destinataire, dans l'ordre d'envoi, en un seul datagramme
+// d'au plus SAFE_DATAGRAM_SIZE octets. Une entree est un paquet complet (historique, compact ou
+// trame fiable), jamais un autre groupe.
+namespace Bundle
+{
+    constexpr size_t HeaderSize = 1;
+    constexpr size_t MaxSize = static_cast<size_t>(SAFE_DATAGRAM_SIZE);
+
+    inline bool IsBundle(const char* data, size_t size)
+    {
+        return size > 0 && static_cast<uint8_t>(data[0]) == BUNDLE_FRAME;
+    }
+
+    inline size_t EntrySize(size_t packetSize)
+    {
+        return PacketCodec::VarintSize(packetSize) + packetSize;
+    }
+
+    // Un paquet trop gros pour partager un datagramme part seul, tel quel
+    inline bool Fits(size_t packetSize)
+    {
+        return packetSize > 0 && HeaderSize + EntrySize(packetSize) <= MaxSize;
+    }
+
+    inline bool Append(GamePacket& bundle, const char* data, size_t size)
+    {
+        if (size == 0 || static_cast<size_t>(bundle.Size()) + EntrySize(size) > MaxSize)
+            return false;
+
+        char* cursor = PacketCodec::PutVarint(bundle.Extend(EntrySize(size)), size);
+        std::memcpy(cursor, data, size);
+        return true;
+    }
+
+    // Regroupe deux paquets : false (et 'bundle' vide) s'ils ne tiennent pas ensemble
+    inline bool Begin(GamePacket& bundle, const GamePacket& first, const GamePacket& second)
+    {
+        const size_t firstSize = static_cast<size_t>(first.Size());
+        const size_t secondSize = static_cast<size_t>(second.Size());
+
+        bundle.Clear();
+        if (firstSize == 0 || secondSize == 0 || HeaderSize + EntrySize(firstSize) + EntrySize(secondSize) > MaxSize)
+            return false;
+
+        *bundle.Extend(HeaderSize) = static_cast<char>(BUNDLE_FRAME);
+        Append(bundle, first.Data(), firstSize);
+        Append(bundle, second.Data(), secondSize);
+        return true;
+    }
+
+    // fn(const char* data, size_t size) par entree, dans l'ordre. false si le groupe est mal forme :
+    // les entrees deja rendues restent valides, la suite est ignoree.
+    template <typename Fn>
+    bool Unpack(const char* data, size_t size, Fn&& fn)
+    {
+        if (!IsBundle(data, size))
+            return false;
+
+        size_t offset = HeaderSize;
+        while (offset < size)
+        {
+            // Varint LEB128 borne : une entree ne depasse jamais MAX_PACKET_SIZE
+            uint64_t entrySize = 0;
+            int shift = 0;
+            for (;;)
+            {
+                if (offset >= size || shift > 14)
+                    return false;
+
+                const uint8_t byte = static_cast<uint8_t>(data[offset++]);
+                entrySize |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                shift += 7;
+
+                if ((byte & 0x80) == 0)
+                    break;
+            }
+
+            if (entrySize == 0 || entrySize > size - offset || IsBundle(data + offset, static_cast<size_t>(entrySize)))
+                return false;
+
+            fn(data + offset, static_cast<size_t>(entrySize));
+            offset += static_cast<size_t>(entrySize);
+        }
+
+        return true;
+    }
+}
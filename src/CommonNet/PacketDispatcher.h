@@ -0,0 +1,94 @@
+#pragma once
+#include "PacketSystem.h"
+#include <functional>
+#include <utility>
+#include <cstdint>
+
+
+// ==== Table de distribution par OpCode ====
+// Tableau dense indexe par l'OpCode : une comparaison de bornes et un appel, sans arbre.
+// Context = ce que le handler recoit en plus du paquet (l'expediteur cote serveur, rien cote client).
+// Les OpCodes hors table ou sans handler et les formats inconnus sont comptes (unknown), de meme
+// que les paquets tronques ou incoherents (malformed) : ils sont abandonnes sans interrompre la boucle.
+// Le format (historique ou compact) est reconnu a l'en-tete et note dans le paquet pour Decode().
+template <typename... Context>
+class PacketDispatcher
+{
+public:
+    static constexpr int TableSize = 16;
+
+    using Handler = std::function<void(GamePacket&, Context...)>;
+
+    void On(OpCode type, Handler handler)
+    {
+        const int index = static_cast<int>(type);
+        if (index >= 0 && index < TableSize)
+            m_handlers[index] = std::move(handler);
+    }
+
+    // Handler type : le paquet est decode avant l'appel, fn(PacketT&, Context...)
+    template <typename PacketT, typename Fn>
+    void On(Fn handler)
+    {
+        static_assert(static_cast<int>(PacketT::Code) >= 0 && static_cast<int>(PacketT::Code) < TableSize, "OpCode hors de la table de distribution.");
+
+        On(PacketT::Code, [handler = std::move(handler)](GamePacket& rawPacket, Context... context) mutable
+        {
+            PacketT packet;
+            packet.Decode(rawPacket);
+            handler(packet, context...);
+        });
+    }
+
+    // Lit l'en-tete (historique ou compact) puis appelle le handler. false si le paquet a ete abandonne.
+    bool Dispatch(GamePacket& packet, Context... context)
+    {
+        PacketHeader header;
+        switch (PacketHeader::Parse(packet.Data(), static_cast<size_t>(packet.Size()), header))
+        {
+        case PacketHeader::Status::Truncated:
+            ++m_malformed;
+            return false;
+
+        case PacketHeader::Status::UnsupportedFormat:
+            ++m_unknown;
+            return false;
+
+        case PacketHeader::Status::Ok:
+            break;
+        }
+
+        packet.ResetRead();
+        packet.ReadBytes(header.size);
+        packet.SetFormat(header.format);
+
+        // Un seul test couvre aussi les OpCodes negatifs
+        const uint32_t index = static_cast<uint32_t>(header.opcode);
+        if (index >= static_cast<uint32_t>(TableSize) || !m_handlers[index])
+        {
+            ++m_unknown;
+            return false;
+        }
+
+        try
+        {
+            m_handlers[index](packet, context...);
+        }
+        catch (const PacketError&)
+        {
+            ++m_malformed;
+            return false;
+        }
+
+        return true;
+    }
+
+    uint64_t GetUnknownPackets() const { return m_unknown; }
+    uint64_t GetMalformedPackets() const { return m_malformed; }
+
+private:
+    Handler m_handlers[TableSize];
+
+    uint64_t m_unknown = 0;
+    uint64_t m_malformed = 0;
+};
@@ -1,6 +1,13 @@
 #pragma once
 #include "NetworkCommon.h"
 #include <string>
+#include <string_view>
+#include <memory>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
 
 
 enum class OpCode : int
@@ -13,7 +20,21 @@ enum class OpCode : int
     Ping = 7,
     PlayerList = 6,
     PlayerState = 8,
-    GameEnd = 9
+    GameEnd = 9,
+    ChannelInfo = 10,
+    RosterSnapshot = 11,
+    RosterResync = 12,
+    ChannelResync = 13
+};
+
+
+// Canal fiable d'un type de paquet, vers les pairs qui ont negocie WIRE_VERSION_RELIABLE
+// (voir ReliableEndpoint). None : datagramme brut, sans octet ajoute.
+enum class ReliableChannel : uint8_t
+{
+    Chat = 0,
+    Game = 1,
+    None = 0xFF
 };
 
 
@@ -22,163 +43,974 @@ class IPacket
 public:
     virtual ~IPacket() = default;
     virtual OpCode GetOpCode() const = 0;
-    virtual void Serialize(GamePacket& packet) const = 0;
+    virtual ReliableChannel GetChannel() const { return ReliableChannel::None; }
+    virtual void Serialize(GamePacket& packet, WireFormat format = WireFormat::Legacy) const = 0;
+
+    // Format lu dans packet.Format() (fixe par la distribution)
     virtual void Deserialize(GamePacket& packet) = 0;
 };
 
 
-// -- Helpers --
+// ==== En-tete ====
+struct PacketHeader
+{
+    enum class Status
+    {
+        Ok,
+        Truncated,          // trop court pour porter un OpCode
+        UnsupportedFormat   // octet de tete inconnu ou version compacte plus recente
+    };
+
+    int opcode = -1;
+    WireFormat format = WireFormat::Legacy;
+    size_t size = 0;    // octets d'en-tete a sauter avant les champs
+
+    // Lit l'en-tete sans rien consommer (aussi utilise par le limiteur de debit, avant copie)
+    static Status Parse(const char* data, size_t length, PacketHeader& header)
+    {
+        if (length == 0)
+            return Status::Truncated;
+
+        const uint8_t first = static_cast<uint8_t>(data[0]);
+        if (first & COMPACT_HEADER)
+        {
+            const uint8_t version = first & COMPACT_VERSION_MASK;
+            if ((first & ~(COMPACT_HEADER | COMPACT_VERSION_MASK)) != 0 || version == 0 || version > WIRE_VERSION)
+                return Status::UnsupportedFormat;
+
+            if (length < 2)
+                return Status::Truncated;
+
+            header.opcode = static_cast<uint8_t>(data[1]);
+            header.format = WireFormat::Compact;
+            header.size = 2;
+            return Status::Ok;
+        }
+
+        if (length < sizeof(int32_t))
+            return Status::Truncated;
+
+        int32_t networkOpcode;
+        std::memcpy(&networkOpcode, data, sizeof(networkOpcode));
+        header.opcode = Net::FromNetwork(networkOpcode);
+        header.format = WireFormat::Legacy;
+        header.size = sizeof(int32_t);
+        return Status::Ok;
+    }
+};
+
+
+// ==== Codec statique ====
+// Chaque paquet decrit ses champs une seule fois, dans l'ordre du fil :
+//     template <typename Self, typename Ar> static void Visit(Self& self, Ar& ar) { ar(self.A, self.B); }
+// Un champ ajoute apres coup se declare en fin de liste par ar.Optional(self.C) : absent d'un
+// paquet historique, il garde sa valeur par defaut (et n'est ecrit que s'il en differe).
+// ar.Named(self.Nom, self.NomId) : un nom accompagne de son id de session (NameTable). Le format
+// historique ne transporte que le nom ; le compact envoie l'id a la place du nom quand il est connu.
+// ar.CompactOnly(self.C) : champ propre au format compact (ids annonces avec leur nom).
+// ar.List(self.Entrees) : std::vector d'un type qui declare son propre Visit, encode entree par entree.
+// Les archives ci-dessous en tirent la taille exacte, l'ecriture et la lecture, sans appel virtuel.
+namespace PacketCodec
+{
+    // Taille encodee exacte (scalaires en taille fixe, chaines = longueur uint16 + octets).
+    // Parcourue avant toute ecriture : c'est elle qui refuse une longueur qui deborde son uint16.
+    struct SizeArchive
+    {
+        size_t size = 0;
+
+        template <typename... Fields>
+        void operator()(const Fields&... fields) { (Add(fields), ...); }
+
+        template <typename T>
+        void Add(const T&)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "Champ non serialisable.");
+            size += sizeof(T);
+        }
+
+        void Add(std::string_view text)
+        {
+            CheckLength(text.size());
+            size += sizeof(uint16_t) + text.size();
+        }
+
+        void Add(const std::string& text) { Add(std::string_view(text)); }
+
+        template <typename T>
+        void Optional(const T& value)
+        {
+            if (!(value == T{}))
+                Add(value);
+        }
+
+        template <typename Str, typename Id>
+        void Named(const Str& name, const Id&) { Add(name); }
+
+        template <typename T>
+        void CompactOnly(const T&) {}
+
+        // Nombre d'entrees (uint16, au plus 0xFFFF) puis chaque entree
+        template <typename T>
+        void List(const std::vector<T>& entries)
+        {
+            CheckLength(entries.size());
+            Add(static_cast<uint16_t>(entries.size()));
+            for (const T& entry : entries)
+            {
+                T::Visit(entry, *this);
+            }
+        }
+
+        static void CheckLength(size_t length)
+        {
+            if (length > UINT16_MAX)
+                throw PacketError("[GamePacket] Overflow: Longueur trop grande pour le format historique.");
+        }
+    };
+
+    // Ecrit dans une zone deja dimensionnee par SizeArchive : aucun test de capacite par champ
+    struct WriteArchive
+    {
+        char* cursor;
+
+        template <typename... Fields>
+        void operator()(const Fields&... fields) { (Put(fields), ...); }
+
+        template <typename T>
+        void Put(const T& value)
+        {
+            const T networkValue = Net::ToNetwork(value);
+            std::memcpy(cursor, &networkValue, sizeof(T));
+            cursor += sizeof(T);
+        }
+
+        void Put(std::string_view text)
+        {
+            Put(static_cast<uint16_t>(text.size()));
+            if (!text.empty())
+                std::memcpy(cursor, text.data(), text.size());
+            cursor += text.size();
+        }
+
+        void Put(const std::string& text) { Put(std::string_view(text)); }
+
+        template <typename T>
+        void Optional(const T& value)
+        {
+            if (!(value == T{}))
+                Put(value);
+        }
+
+        template <typename Str, typename Id>
+        void Named(const Str& name, const Id&) { Put(name); }
+
+        template <typename T>
+        void CompactOnly(const T&) {}
+
+        template <typename T>
+        void List(const std::vector<T>& entries)
+        {
+            Put(static_cast<uint16_t>(entries.size()));
+            for (const T& entry : entries)
+            {
+                T::Visit(entry, *this);
+            }
+        }
+    };
+
+    // Lecture bornee par GamePacket (PacketError si le paquet est trop court)
+    struct ReadArchive
+    {
+        GamePacket& packet;
+
+        template <typename... Fields>
+        void operator()(Fields&... fields) { (packet >> ... >> fields); }
+
+        template <typename T>
+        void Optional(T& value)
+        {
+            if (packet.Remaining() > 0)
+                packet >> value;
+            else
+                value = T{};
+        }
+
+        template <typename Str, typename Id>
+        void Named(Str& name, Id& id)
+        {
+            packet >> name;
+            id = Id{};
+        }
+
+        template <typename T>
+        void CompactOnly(T& value) { value = T{}; }
+
+        template <typename T>
+        void List(std::vector<T>& entries)
+        {
+            uint16_t count = 0;
+            packet >> count;
+
+            // Une entree occupe au moins un octet : borne l'allocation avant de lire
+            if (count > packet.Remaining())
+                throw PacketError("[GamePacket] Buffer Underflow: Liste trop longue.");
+
+            entries.resize(count);
+            for (T& entry : entries)
+            {
+                T::Visit(entry, *this);
+            }
+        }
+    };
+
+
+    // ==== Format compact ====
+    // [COMPACT_HEADER | version][OpCode][bits...][champs presents...]
+    // Un bit par champ, dans l'ordre de Visit : la valeur pour un bool, la presence sinon.
+    // Un champ egal a sa valeur par defaut (celle d'un paquet construit par defaut) n'est pas
+    // ecrit. Entiers et longueurs en varint LEB128 (zigzag pour les signes), chaines sans borne
+    // de 64 Ko, autres scalaires en taille fixe big-endian.
+
+    template <typename T>
+    constexpr bool IsText = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+    template <typename T>
+    constexpr bool IsVarint = (std::is_integral_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>;
+
+    inline size_t VarintSize(uint64_t value)
+    {
+        size_t size = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    inline char* PutVarint(char* cursor, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            *cursor++ = static_cast<char>(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        *cursor++ = static_cast<char>(value);
+        return cursor;
+    }
+
+    inline uint64_t ReadVarint(GamePacket& packet)
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t byte = 0;
+            packet >> byte;
+
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+
+        throw PacketError("[GamePacket] Varint trop long.");
+    }
+
+    // Bits de presence, octet de poids faible en tete
+    inline void PutBits(char* out, uint64_t bits, size_t bitBytes)
+    {
+        for (size_t i = 0; i < bitBytes; ++i)
+        {
+            out[i] = static_cast<char>(bits >> (8 * i));
+        }
+    }
+
+    inline uint64_t ReadBits(GamePacket& packet, size_t bitBytes)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < bitBytes; ++i)
+        {
+            uint8_t byte = 0;
+            packet >> byte;
+            bits |= static_cast<uint64_t>(byte) << (8 * i);
+        }
+        return bits;
+    }
+
+    template <typename T>
+    uint64_t ToVarint(T value)
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return ToVarint(static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            const int64_t wide = value;
+            return (static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63);
+        }
+        else
+        {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    template <typename T>
+    T FromVarint(uint64_t raw)
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            return static_cast<T>(FromVarint<std::underlying_type_t<T>>(raw));
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            const int64_t wide = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+            if (static_cast<int64_t>(static_cast<T>(wide)) != wide)
+                throw PacketError("[GamePacket] Varint hors limites.");
+            return static_cast<T>(wide);
+        }
+        else
+        {
+            if (static_cast<uint64_t>(static_cast<T>(raw)) != raw)
+                throw PacketError("[GamePacket] Varint hors limites.");
+            return static_cast<T>(raw);
+        }
+    }
+
+    // Adresses des champs d'un paquet de reference, dans l'ordre de Visit
+    struct FieldArchive
+    {
+        std::vector<const void*> fields;
+
+        template <typename... Fields>
+        void operator()(const Fields&... values) { (fields.push_back(&values), ...); }
+
+        template <typename T>
+        void Optional(const T& value) { fields.push_back(&value); }
+
+        template <typename Str, typename Id>
+        void Named(const Str& name, const Id& id) { (*this)(name, id); }
+
+        template <typename T>
+        void CompactOnly(const T& value) { fields.push_back(&value); }
+
+        // Une liste n'a qu'un bit (non vide) : sa valeur par defaut n'est jamais lue
+        template <typename T>
+        void List(const std::vector<T>& entries) { fields.push_back(&entries); }
+    };
+
+    template <typename T>
+    const T& DefaultOf(const void* const* defaults, int field)
+    {
+        return *static_cast<const T*>(defaults[field]);
+    }
+
+    // Valeurs par defaut des champs de T (T construit par defaut), calculees une fois par type
+    template <typename T>
+    const std::vector<const void*>& DefaultFields()
+    {
+        static const T reference{};
+        static const std::vector<const void*> fields = []
+        {
+            FieldArchive ar;
+            T::Visit(reference, ar);
+            return std::move(ar.fields);
+        }();
+
+        return fields;
+    }
+
+    template <typename T>
+    size_t BitBytesOf()
+    {
+        static const size_t bitBytes = (DefaultFields<T>().size() + 7) / 8;
+        return bitBytes;
+    }
+
+    struct CompactSizeArchive
+    {
+        const void* const* defaults;
+        int field = 0;
+        size_t size = 0;
+
+        template <typename... Fields>
+        void operator()(const Fields&... values) { (Add(values), ...); }
+
+        template <typename T>
+        void Optional(const T& value) { Add(value); }
+
+        template <typename T>
+        void CompactOnly(const T& value) { Add(value); }
+
+        // Bit = liste non vide, puis varint du nombre d'entrees et chaque entree avec ses propres bits
+        template <typename T>
+        void List(const std::vector<T>& entries)
+        {
+            ++field;
+            if (entries.empty())
+                return;
+
+            size += VarintSize(entries.size());
+            for (const T& entry : entries)
+            {
+                CompactSizeArchive nested{ DefaultFields<T>().data() };
+                T::Visit(entry, nested);
+                size += BitBytesOf<T>() + nested.size;
+            }
+        }
+
+        // Deux bits : le nom n'est ecrit que si l'id est absent
+        template <typename Str, typename Id>
+        void Named(const Str& name, const Id& id)
+        {
+            if (id == Id{})
+            {
+                Add(name);
+                ++field;
+            }
+            else
+            {
+                ++field;
+                Add(id);
+            }
+        }
+
+        template <typename T>
+        void Add(const T& value)
+        {
+            const int index = field++;
+            if constexpr (!std::is_same_v<T, bool>)
+            {
+                if (value == DefaultOf<T>(defaults, index))
+                    return;
+
+                if constexpr (IsText<T>)
+                    size += VarintSize(value.size()) + value.size();
+                else if constexpr (IsVarint<T>)
+                    size += VarintSize(ToVarint(value));
+                else
+                    size += sizeof(T);
+            }
+        }
+    };
+
+    struct CompactWriteArchive
+    {
+        const void* const* defaults;
+        char* cursor;
+        int field = 0;
+        uint64_t bits = 0;
+
+        template <typename... Fields>
+        void operator()(const Fields&... values) { (Put(values), ...); }
+
+        template <typename T>
+        void Optional(const T& value) { Put(value); }
+
+        template <typename T>
+        void CompactOnly(const T& value) { Put(value); }
+
+        template <typename T>
+        void List(const std::vector<T>& entries)
+        {
+            const int index = field++;
+            if (entries.empty())
+                return;
+
+            bits |= uint64_t(1) << index;
+            cursor = PutVarint(cursor, entries.size());
+            for (const T& entry : entries)
+            {
+                const size_t bitBytes = BitBytesOf<T>();
+                CompactWriteArchive nested{ DefaultFields<T>().data(), cursor + bitBytes };
+                T::Visit(entry, nested);
+
+                PutBits(cursor, nested.bits, bitBytes);
+                cursor = nested.cursor;
+            }
+        }
+
+        template <typename Str, typename Id>
+        void Named(const Str& name, const Id& id)
+        {
+            if (id == Id{})
+            {
+                Put(name);
+                ++field;
+            }
+            else
+            {
+                ++field;
+                Put(id);
+            }
+        }
+
+        template <typename T>
+        void Put(const T& value)
+        {
+            const int index = field++;
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                bits |= static_cast<uint64_t>(value) << index;
+            }
+            else
+            {
+                if (value == DefaultOf<T>(defaults, index))
+                    return;
+
+                bits |= uint64_t(1) << index;
+                if constexpr (IsText<T>)
+                {
+                    cursor = PutVarint(cursor, value.size());
+                    if (!value.empty())
+                        std::memcpy(cursor, value.data(), value.size());
+                    cursor += value.size();
+                }
+                else if constexpr (IsVarint<T>)
+                {
+                    cursor = PutVarint(cursor, ToVarint(value));
+                }
+                else
+                {
+                    const T networkValue = Net::ToNetwork(value);
+                    std::memcpy(cursor, &networkValue, sizeof(T));
+                    cursor += sizeof(T);
+                }
+            }
+        }
+    };
+
+    struct CompactReadArchive
+    {
+        GamePacket& packet;
+        const void* const* defaults;
+        uint64_t bits = 0;
+        int field = 0;
+
+        template <typename... Fields>
+        void operator()(Fields&... values) { (Get(values), ...); }
+
+        template <typename T>
+        void Optional(T& value) { Get(value); }
+
+        template <typename T>
+        void CompactOnly(T& value) { Get(value); }
+
+        template <typename T>
+        void List(std::vector<T>& entries)
+        {
+            const int index = field++;
+            entries.clear();
+            if (((bits >> index) & 1) == 0)
+                return;
+
+            // Chaque entree porte au moins ses bits de presence : borne l'allocation avant de lire
+            const uint64_t count = ReadVarint(packet);
+            if (count > packet.Remaining())
+                throw PacketError("[GamePacket] Buffer Underflow: Liste trop longue.");
+
+            entries.resize(static_cast<size_t>(count));
+            for (T& entry : entries)
+            {
+                CompactReadArchive nested{ packet, DefaultFields<T>().data() };
+                nested.bits = ReadBits(packet, BitBytesOf<T>());
+                T::Visit(entry, nested);
+            }
+        }
+
+        // Nom absent (id seul) : le nom garde sa valeur par defaut, a resoudre par l'id
+        template <typename Str, typename Id>
+        void Named(Str& name, Id& id)
+        {
+            Get(name);
+            Get(id);
+        }
+
+        template <typename T>
+        void Get(T& value)
+        {
+            const int index = field++;
+            const bool bit = (bits >> index) & 1;
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                value = bit;
+            }
+            else if (!bit)
+            {
+                value = DefaultOf<T>(defaults, index);
+            }
+            else if constexpr (IsText<T>)
+            {
+                const size_t size = static_cast<size_t>(ReadVarint(packet));
+                if (size > packet.Remaining())
+                    throw PacketError("[GamePacket] Buffer Underflow: String trop longue.");
+
+                value = T(packet.ReadBytes(size));
+            }
+            else if constexpr (IsVarint<T>)
+            {
+                value = FromVarint<T>(ReadVarint(packet));
+            }
+            else
+            {
+                packet >> value;
+            }
+        }
+    };
+
+    // Octets d'une entree dans ar.List : remplir un datagramme sans reencoder la liste entiere
+    template <typename T>
+    size_t ListEntrySize(const T& entry, WireFormat format)
+    {
+        if (format == WireFormat::Compact)
+        {
+            CompactSizeArchive ar{ DefaultFields<T>().data() };
+            T::Visit(entry, ar);
+            return BitBytesOf<T>() + ar.size;
+        }
+
+        SizeArchive ar;
+        T::Visit(entry, ar);
+        return ar.size;
+    }
+}
 
 
 // ==== Base Packet ====
-template <OpCode Op>
+// CRTP : Encode / Decode / EncodedSize sont resolus a la compilation. Serialize et Deserialize
+// (IPacket) restent pour l'usage dynamique et passent par le meme codec.
+template <typename Derived, OpCode Op>
 struct PacketBase : IPacket
 {
+    static constexpr OpCode Code = Op;
+
+    // Redefini par les paquets a livrer de facon fiable et ordonnee
+    static constexpr ReliableChannel Channel = ReliableChannel::None;
+
+    static_assert(static_cast<int>(Op) >= 0 && static_cast<int>(Op) < 256, "L'en-tete compact porte l'OpCode sur un octet.");
+
     OpCode GetOpCode() const override
     {
         return Op;
     }
 
-    void Serialize(GamePacket& packet) const override
+    ReliableChannel GetChannel() const override
+    {
+        return Derived::Channel;
+    }
+
+    // En-tete compris
+    size_t EncodedSize(WireFormat format = WireFormat::Legacy) const
     {
-        packet << static_cast<int>(Op);
-        WritePayload(packet);
+        if (format == WireFormat::Compact)
+        {
+            PacketCodec::CompactSizeArchive ar{ PacketCodec::DefaultFields<Derived>().data() };
+            Derived::Visit(AsDerived(), ar);
+            return 2 + PacketCodec::BitBytesOf<Derived>() + ar.size;
+        }
+
+        PacketCodec::SizeArchive ar;
+        Derived::Visit(AsDerived(), ar);
+        return sizeof(int32_t) + ar.size;
     }
 
-    void Deserialize(GamePacket& packet) override
+    // Ajoute le paquet a la fin de 'packet' en un seul redimensionnement
+    void Encode(GamePacket& packet, WireFormat format = WireFormat::Legacy) const
     {
-        ReadPayload(packet);
+        char* out = packet.Extend(EncodedSize(format));
+
+        if (format == WireFormat::Compact)
+        {
+            const size_t bitBytes = PacketCodec::BitBytesOf<Derived>();
+            out[0] = static_cast<char>(COMPACT_HEADER | WIRE_VERSION);
+            out[1] = static_cast<char>(Op);
+
+            PacketCodec::CompactWriteArchive ar{ PacketCodec::DefaultFields<Derived>().data(), out + 2 + bitBytes };
+            Derived::Visit(AsDerived(), ar);
+
+            PacketCodec::PutBits(out + 2, ar.bits, bitBytes);
+            return;
+        }
+
+        PacketCodec::WriteArchive ar{ out };
+        ar(static_cast<int32_t>(Op));
+        Derived::Visit(AsDerived(), ar);
     }
 
-    virtual void WritePayload(GamePacket& packet) const {}
-    virtual void ReadPayload(GamePacket& packet) {}
+    // Lit les champs dans le format du paquet (l'en-tete a deja ete consomme par la distribution)
+    void Decode(GamePacket& packet)
+    {
+        if (packet.Format() == WireFormat::Compact)
+        {
+            PacketCodec::CompactReadArchive ar{ packet, PacketCodec::DefaultFields<Derived>().data() };
+            ar.bits = PacketCodec::ReadBits(packet, PacketCodec::BitBytesOf<Derived>());
+
+            Derived::Visit(static_cast<Derived&>(*this), ar);
+            return;
+        }
+
+        PacketCodec::ReadArchive ar{ packet };
+        Derived::Visit(static_cast<Derived&>(*this), ar);
+    }
+
+    void Serialize(GamePacket& packet, WireFormat format = WireFormat::Legacy) const final
+    {
+        Encode(packet, format);
+    }
+
+    void Deserialize(GamePacket& packet) final
+    {
+        Decode(packet);
+    }
+
+    // Pas de champ par defaut
+    template <typename Self, typename Ar>
+    static void Visit(Self&, Ar&) {}
+
+private:
+    const Derived& AsDerived() const { return static_cast<const Derived&>(*this); }
 };
 
 
+// Paquet concret encodable sans passer par la vtable
+template <typename T>
+concept StaticPacket = std::derived_from<T, IPacket> && requires(const T& packet, GamePacket& out)
+{
+    { T::Code } -> std::convertible_to<OpCode>;
+    packet.Encode(out);
+};
+
+
+// -- Helpers --
+
+
+// ==== Paquet pre-encode ====
+// Serialise une seule fois puis partage, immuable, entre tous ses destinataires.
+using EncodedPacket = std::shared_ptr<const GamePacket>;
+
+inline EncodedPacket EncodePacket(const IPacket& packet, WireFormat format = WireFormat::Legacy)
+{
+    auto encoded = std::make_shared<GamePacket>();
+    packet.Serialize(*encoded, format);
+    return encoded;
+}
+
+template <StaticPacket PacketT>
+inline EncodedPacket EncodePacket(const PacketT& packet, WireFormat format = WireFormat::Legacy)
+{
+    auto encoded = std::make_shared<GamePacket>();
+    packet.Encode(*encoded, format);
+    return encoded;
+}
+
+
 // ==== Connection State Packet ====
-struct PacketConnectionState : PacketBase<OpCode::ConnectionState>
+struct PacketConnectionState : PacketBase<PacketConnectionState, OpCode::ConnectionState>
 {
+    // Arrivees / departs sur le canal du chat : l'id d'un joueur precede ses messages
+    static constexpr ReliableChannel Channel = ReliableChannel::Chat;
+
     bool IsConnected = false;
     std::string Pseudo;
     uint8_t ColorID = 0;
 
-    void WritePayload(GamePacket& packet) const override
-    {
-        packet << IsConnected << Pseudo << ColorID;
-    }
+    // Login : version du format compact comprise par le client (0 = historique uniquement)
+    uint8_t WireVersion = 0;
 
-    void ReadPayload(GamePacket& packet) override
+    // Arrivee / depart (compact) : id de session du joueur, annonce ici avec son pseudo
+    uint16_t PlayerId = 0;
+
+    // Arrivee / depart (compact) : version du roster apres ce changement (voir PacketRosterSnapshot)
+    uint32_t RosterVersion = 0;
+
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet >> IsConnected >> Pseudo >> ColorID;
+        ar(self.IsConnected, self.Pseudo, self.ColorID);
+        ar.Optional(self.WireVersion);
+        ar.CompactOnly(self.PlayerId);
+        ar.CompactOnly(self.RosterVersion);
     }
 };
 
 
 // ==== Chat Packet ====
-struct PacketChat : PacketBase<OpCode::Chat>
+// Str = std::string (le paquet possede ses champs) ou std::string_view (PacketChatView : les champs
+// pointent dans le tampon recu, ou dans des chaines qui survivent a l'encodage ; aucune allocation).
+template <typename Str>
+struct BasicPacketChat : PacketBase<BasicPacketChat<Str>, OpCode::Chat>
 {
-    std::string Sender;
-    std::string Message;
-    std::string ChannelName = "Global";
-    std::string Target = "";
+    static constexpr ReliableChannel Channel = ReliableChannel::Chat;
 
-    void WritePayload(GamePacket& packet) const override
-    {
-        packet << Sender << Message << ChannelName << Target;
-    }
+    Str Sender;
+    Str Message;
+    Str ChannelName = "Global";
+    Str Target = "";
 
-    void ReadPayload(GamePacket& packet) override
+    // Ids de session (0 = inconnu, le nom part en clair). En compact, un id remplace son nom.
+    uint16_t SenderId = 0;
+    uint16_t ChannelId = 0;
+    uint16_t TargetId = 0;
+
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet >> Sender >> Message >> ChannelName >> Target;
+        ar.Named(self.Sender, self.SenderId);
+        ar(self.Message);
+        ar.Named(self.ChannelName, self.ChannelId);
+        ar.Named(self.Target, self.TargetId);
     }
 };
 
+using PacketChat = BasicPacketChat<std::string>;
+using PacketChatView = BasicPacketChat<std::string_view>;
+
 
 // ==== Start Game Packet ====
-struct PacketGameStart : PacketBase<OpCode::GameStart>
+struct PacketGameStart : PacketBase<PacketGameStart, OpCode::GameStart>
 {
+    static constexpr ReliableChannel Channel = ReliableChannel::Game;
+
     // No payload
 };
 
 
 // ==== Game Data Packet ====
-struct PacketGameData : PacketBase<OpCode::GameData>
+struct PacketGameData : PacketBase<PacketGameData, OpCode::GameData>
 {
     int Value = 0;
 
-    void WritePayload(GamePacket& packet) const override
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet << Value;
-    }
-
-    void ReadPayload(GamePacket& packet) override
-    {
-        packet >> Value;
+        ar(self.Value);
     }
 };
 
 
 // ==== Game Result Packet ====
-struct PacketGameResult : PacketBase<OpCode::GameResult>
+struct PacketGameResult : PacketBase<PacketGameResult, OpCode::GameResult>
 {
-    std::string WinnerName;
+    static constexpr ReliableChannel Channel = ReliableChannel::Game;
 
-    void WritePayload(GamePacket& packet) const override
-    {
-        packet << WinnerName;
-    }
+    std::string WinnerName;
+    uint16_t WinnerId = 0;
 
-    void ReadPayload(GamePacket& packet) override
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet >> WinnerName;
+        ar.Named(self.WinnerName, self.WinnerId);
     }
 };
 
 
 // ==== Ping Packet ====
-struct PacketPing : PacketBase<OpCode::Ping>
+struct PacketPing : PacketBase<PacketPing, OpCode::Ping>
 {
     // No payload
 };
 
 
 // ---- Player List Packet ----
-struct PacketPlayerList : PacketBase<OpCode::PlayerList>
+struct PacketPlayerList : PacketBase<PacketPlayerList, OpCode::PlayerList>
 {
     std::string Pseudo;
     uint8_t ColorID = 0;
+    uint16_t PlayerId = 0;
 
-    void WritePayload(GamePacket& packet) const override
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet << Pseudo << ColorID;
+        ar(self.Pseudo, self.ColorID);
+        ar.CompactOnly(self.PlayerId);
     }
+};
+
+
+// ==== Player State Packet (Spectator) ====
+struct PacketPlayerState : PacketBase<PacketPlayerState, OpCode::PlayerState>
+{
+    bool IsSpectator = false;
 
-    void ReadPayload(GamePacket& packet) override
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet >> Pseudo >> ColorID;
+        ar(self.IsSpectator);
     }
 };
 
 
-// ==== Player State Packet (Spectator) ====
-struct PacketPlayerState : PacketBase<OpCode::PlayerState>
+// ==== Game End Packet ====
+struct PacketGameEnd : PacketBase<PacketGameEnd, OpCode::GameEnd>
 {
-    bool IsSpectator = false;
+    static constexpr ReliableChannel Channel = ReliableChannel::Game;
 
-    void WritePayload(GamePacket& packet) const override
+    // Forces return to lobby
+};
+
+
+// ==== Channel Info Packet ====
+// Annonce l'id de session d'un canal (clients compacts uniquement), sur le canal fiable du chat :
+// l'id arrive avant les messages qui l'utilisent
+struct PacketChannelInfo : PacketBase<PacketChannelInfo, OpCode::ChannelInfo>
+{
+    static constexpr ReliableChannel Channel = ReliableChannel::Chat;
+
+    uint16_t ChannelId = 0;
+    std::string Name;
+
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet << IsSpectator;
+        ar(self.ChannelId, self.Name);
     }
+};
+
 
-    void ReadPayload(GamePacket& packet) override
+// ==== Roster Snapshot Packet ====
+// Liste des joueurs (clients compacts) : autant d'entrees que possible par datagramme de
+// SAFE_DATAGRAM_SIZE, en PartCount parties de la meme Version. Ensuite, seules les arrivees et
+// departs (PacketConnectionState) sont envoyes, numerotes Version + 1, + 2...
+struct RosterEntry
+{
+    uint16_t PlayerId = 0;
+    std::string Pseudo;
+    uint8_t ColorID = 0;
+
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
     {
-        packet >> IsSpectator;
+        ar(self.PlayerId, self.Pseudo, self.ColorID);
     }
 };
 
+struct PacketRosterSnapshot : PacketBase<PacketRosterSnapshot, OpCode::RosterSnapshot>
+{
+    uint32_t Version = 0;
+    uint16_t Part = 0;
+    uint16_t PartCount = 0;
+    std::vector<RosterEntry> Entries;
 
-// ==== Game End Packet ====
-struct PacketGameEnd : PacketBase<OpCode::GameEnd>
+    template <typename Self, typename Ar>
+    static void Visit(Self& self, Ar& ar)
+    {
+        ar(self.Version, self.Part, self.PartCount);
+        ar.List(self.Entries);
+    }
+};
+
+
+// ==== Roster Resync Packet ====
+// Client -> serveur : une version du roster a ete manquee, renvoyer un snapshot complet
+struct PacketRosterResync : PacketBase<PacketRosterResync, OpCode::RosterResync>
 {
-    // Forces return to lobby
+    // No payload
+};
+
+
+// ==== Channel Resync Packet ====
+// Client -> serveur : un id de canal inconnu est arrive, renvoyer les PacketChannelInfo de ses canaux
+struct PacketChannelResync : PacketBase<PacketChannelResync, OpCode::ChannelResync>
+{
+    // No payload
 };
@@ -0,0 +1,453 @@
+#pragma once
+#include "NetworkCommon.h"
+#include <vector>
+#include <deque>
+#include <array>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+// ==== Trame fiable ====
+// [RELIABLE_FRAME][canal | HasAck][seq u16][ordre u16][ack u16][ackBits u32][paquet, en-tete compris]
+// seq : numero de la trame chez l'emetteur, unique par envoi (une retransmission prend un nouveau seq).
+// ordre : rang du message dans son canal, livre dans cet ordre. ack / ackBits : dernier seq recu
+// et les 32 precedents. Trame d'acquittement seul : canal = NoChannel, sans paquet.
+namespace Reliable
+{
+    constexpr size_t HeaderSize = 1 + 1 + 2 + 2 + 2 + 4;
+    constexpr uint8_t HasAck = 0x80;
+    constexpr uint8_t ChannelMask = 0x7F;
+    constexpr uint8_t NoChannel = 0x7F;
+
+    // a plus recent que b, en arithmetique modulo 2^16
+    inline bool SeqNewer(uint16_t a, uint16_t b)
+    {
+        return static_cast<int16_t>(static_cast<uint16_t>(a - b)) > 0;
+    }
+}
+
+
+struct ReliableStats
+{
+    uint64_t sentFrames = 0;
+    uint64_t retransmits = 0;
+    uint64_t ackOnlyFrames = 0;
+    uint64_t delivered = 0;
+    uint64_t duplicates = 0;
+    uint64_t outOfWindow = 0;   // trop en avance sur le canal : ignore, non acquitte
+    uint64_t queueFull = 0;     // message refuse a l'envoi, file du canal pleine
+
+    ReliableStats& operator+=(const ReliableStats& other)
+    {
+        sentFrames += other.sentFrames;
+        retransmits += other.retransmits;
+        ackOnlyFrames += other.ackOnlyFrames;
+        delivered += other.delivered;
+        duplicates += other.duplicates;
+        outOfWindow += other.outOfWindow;
+        queueFull += other.queueFull;
+        return *this;
+    }
+};
+
+
+// ==== Extremite fiable (un pair) ====
+// Send() met un paquet deja encode en file sur un canal ; Service() emet les nouveaux messages
+// dans la limite de la fenetre, les retransmissions echues et l'ack en attente (porte par la
+// premiere trame emise, sinon par une trame d'ack seul). Receive() traite les acks d'une trame
+// recue et livre ses paquets dans l'ordre du canal.
+// RTO d'apres la RFC 6298 (SRTT + 4 RTTVAR, borne), double a chaque retransmission d'un message.
+// Un thread par extremite (thread de jeu cote serveur, thread principal cote client).
+class ReliableEndpoint
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int ChannelCount = 2;
+    static constexpr int MaxInFlight = 32;       // messages non acquittes sur le fil : tient dans ack + ackBits
+    static constexpr int MaxQueued = 256;        // messages par canal, en attente d'envoi ou d'ack
+    static constexpr int ReorderWindow = 64;     // messages gardes en avance de l'ordre attendu, par canal
+
+    static constexpr auto InitialRto = std::chrono::milliseconds(250);
+    static constexpr auto MinRto = std::chrono::milliseconds(100);
+    static constexpr auto MaxRto = std::chrono::milliseconds(2000);
+
+    // false si la file du canal est pleine (message abandonne et compte)
+    bool Send(int channel, const char* data, size_t size)
+    {
+        if (channel < 0 || channel >= ChannelCount)
+            return false;
+
+        SendChannel& out = m_send[channel];
+        if (out.messages.size() >= static_cast<size_t>(MaxQueued))
+        {
+            ++m_stats.queueFull;
+            return false;
+        }
+
+        Message& message = out.messages.emplace_back();
+        message.order = static_cast<uint16_t>(out.firstOrder + out.messages.size() - 1);
+        message.payload.assign(data, data + size);
+        return true;
+    }
+
+    // newFrame() -> GamePacket* vide a remplir (nullptr : rien de plus a emettre)
+    template <typename FrameFn>
+    void Service(Clock::time_point now, FrameFn&& newFrame)
+    {
+        // Echeance recalculee au passage : NextDeadline() n'a plus a parcourir les files
+        Clock::time_point next = Clock::time_point::max();
+
+        for (int channel = 0; channel < ChannelCount; ++channel)
+        {
+            SendChannel& out = m_send[channel];
+            for (Message& message : out.messages)
+            {
+                if (message.acked)
+                    continue;
+
+                // Un nouveau message attend qu'il y ait de la place sur le fil et dans la fenetre de
+                // reordonnancement du pair (la tete de file, non acquittee, n'y est pas encore livree)
+                const bool due = message.transmissions > 0
+                    ? now >= message.deadline
+                    : m_inFlight < MaxInFlight && static_cast<uint16_t>(message.order - out.firstOrder) < ReorderWindow;
+
+                if (due)
+                {
+                    GamePacket* frame = newFrame();
+                    if (frame == nullptr)
+                    {
+                        // Le reste n'a pas ete vu : a reprendre au plus tot
+                        m_nextDeadline = now;
+                        return;
+                    }
+
+                    Transmit(*frame, static_cast<uint8_t>(channel), message, now);
+                }
+
+                if (message.transmissions > 0)
+                    next = std::min(next, message.deadline);
+            }
+        }
+
+        m_nextDeadline = next;
+
+        if (m_ackPending)
+        {
+            if (GamePacket* frame = newFrame())
+            {
+                WriteHeader(*frame, Reliable::NoChannel, 0, 0);
+                ++m_stats.ackOnlyFrames;
+            }
+        }
+    }
+
+    // Trame d'ack seul au prochain Service() : previent le pair que la fiabilite est active
+    void Announce() { m_ackPending = true; }
+
+    // deliver(GamePacket&) pour chaque paquet livrable. false si la trame est illisible.
+    template <typename DeliverFn>
+    bool Receive(const char* data, size_t size, Clock::time_point now, DeliverFn&& deliver)
+    {
+        if (size < Reliable::HeaderSize || static_cast<uint8_t>(data[0]) != RELIABLE_FRAME)
+            return false;
+
+        const uint8_t flags = static_cast<uint8_t>(data[1]);
+        const uint8_t channel = flags & Reliable::ChannelMask;
+        const uint16_t seq = ReadU16(data + 2);
+        const uint16_t order = ReadU16(data + 4);
+
+        if (flags & Reliable::HasAck)
+            ProcessAcks(ReadU16(data + 6), ReadU32(data + 8), now);
+
+        if (channel == Reliable::NoChannel)
+            return true;
+
+        if (channel >= ChannelCount)
+            return false;
+
+        ReceiveChannel& in = m_receive[channel];
+        const int distance = static_cast<int16_t>(static_cast<uint16_t>(order - in.expected));
+
+        // Trop loin devant : pas de place pour l'attendre, on ne l'acquitte pas (il reviendra)
+        if (distance >= ReorderWindow)
+        {
+            ++m_stats.outOfWindow;
+            return true;
+        }
+
+        MarkReceived(seq);
+
+        Pending& slot = in.pending[order % ReorderWindow];
+        if (distance < 0 || (distance > 0 && slot.present))
+        {
+            // Deja livre ou deja en attente : l'ack renvoye suffit (le notre s'est perdu)
+            ++m_stats.duplicates;
+            return true;
+        }
+
+        if (distance > 0)
+        {
+            slot.present = true;
+            slot.payload.assign(data + Reliable::HeaderSize, data + size);
+            return true;
+        }
+
+        GamePacket packet(data + Reliable::HeaderSize, static_cast<int>(size - Reliable::HeaderSize));
+        ++in.expected;
+        ++m_stats.delivered;
+        deliver(packet);
+
+        // Les suivants deja arrives sont debloques
+        while (true)
+        {
+            Pending& next = in.pending[in.expected % ReorderWindow];
+            if (!next.present)
+                break;
+
+            GamePacket buffered(next.payload.data(), static_cast<int>(next.payload.size()));
+            next.present = false;
+            next.payload.clear();
+            ++in.expected;
+            ++m_stats.delivered;
+            deliver(buffered);
+        }
+
+        return true;
+    }
+
+    // Prochaine retransmission (time_point::max() si rien n'est en vol), calculee au dernier
+    // Service() : un ack recu depuis peut la rendre en avance, jamais en retard
+    Clock::time_point NextDeadline() const { return m_nextDeadline; }
+
+    // Rien en file, rien a acquitter : Service() n'a rien a faire
+    bool IsIdle() const
+    {
+        return !m_ackPending && m_send[0].messages.empty() && m_send[1].messages.empty();
+    }
+
+    Clock::duration GetRto() const { return m_rto; }
+    Clock::duration GetSmoothedRtt() const { return m_srtt; }
+    const ReliableStats& GetStats() const { return m_stats; }
+
+private:
+    static_assert(ChannelCount <= Reliable::NoChannel, "Le canal tient sur 7 bits.");
+    static_assert(MaxInFlight <= 33, "La fenetre d'ack couvre 33 seq.");
+
+    struct Message
+    {
+        uint16_t order = 0;
+        uint16_t seq = 0;
+        bool acked = false;
+        int transmissions = 0;
+        Clock::time_point sentAt;
+        Clock::time_point deadline;
+        std::vector<char> payload;
+    };
+
+    struct SendChannel
+    {
+        uint16_t firstOrder = 0;       // ordre du message en tete de file
+        std::deque<Message> messages;  // ordres consecutifs ; la tete part des qu'elle est acquittee
+    };
+
+    struct Pending
+    {
+        bool present = false;
+        std::vector<char> payload;
+    };
+
+    struct ReceiveChannel
+    {
+        uint16_t expected = 0;
+        std::array<Pending, ReorderWindow> pending;
+    };
+
+    // seq emis -> message, pour resoudre les acks (un seq trop ancien est ecrase : le message repart)
+    struct SentFrame
+    {
+        bool live = false;
+        uint16_t seq = 0;
+        uint8_t channel = 0;
+        uint16_t order = 0;
+    };
+
+    static uint16_t ReadU16(const char* data)
+    {
+        uint16_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return Net::FromNetwork(value);
+    }
+
+    static uint32_t ReadU32(const char* data)
+    {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return Net::FromNetwork(value);
+    }
+
+    static void WriteU16(char* out, uint16_t value)
+    {
+        value = Net::ToNetwork(value);
+        std::memcpy(out, &value, sizeof(value));
+    }
+
+    static void WriteU32(char* out, uint32_t value)
+    {
+        value = Net::ToNetwork(value);
+        std::memcpy(out, &value, sizeof(value));
+    }
+
+    void WriteHeader(GamePacket& frame, uint8_t channel, uint16_t seq, uint16_t order)
+    {
+        char* out = frame.Extend(Reliable::HeaderSize);
+        out[0] = static_cast<char>(RELIABLE_FRAME);
+        out[1] = static_cast<char>(channel | (m_hasReceived ? Reliable::HasAck : 0));
+        WriteU16(out + 2, seq);
+        WriteU16(out + 4, order);
+        WriteU16(out + 6, m_remoteSeq);
+        WriteU32(out + 8, m_receivedBits);
+
+        // Toute trame porte l'ack courant
+        m_ackPending = false;
+    }
+
+    void Transmit(GamePacket& frame, uint8_t channel, Message& message, Clock::time_point now)
+    {
+        const uint16_t seq = m_nextSeq++;
+
+        WriteHeader(frame, channel, seq, message.order);
+        if (!message.payload.empty())
+            std::memcpy(frame.Extend(message.payload.size()), message.payload.data(), message.payload.size());
+
+        if (message.transmissions == 0)
+            ++m_inFlight;
+        else
+            ++m_stats.retransmits;
+
+        // Attente doublee a chaque nouvel essai du meme message
+        Clock::duration rto = m_rto;
+        for (int i = 0; i < message.transmissions && rto < MaxRto; ++i)
+        {
+            rto *= 2;
+        }
+
+        message.seq = seq;
+        message.sentAt = now;
+        message.deadline = now + std::min<Clock::duration>(rto, MaxRto);
+        ++message.transmissions;
+
+        m_sent[seq % m_sent.size()] = { true, seq, channel, message.order };
+        ++m_stats.sentFrames;
+    }
+
+    void ProcessAcks(uint16_t ack, uint32_t bits, Clock::time_point now)
+    {
+        for (uint32_t i = 0; i <= 32; ++i)
+        {
+            if (i > 0 && (bits & (1u << (i - 1))) == 0)
+                continue;
+
+            const uint16_t seq = static_cast<uint16_t>(ack - i);
+            SentFrame& sent = m_sent[seq % m_sent.size()];
+            if (!sent.live || sent.seq != seq)
+                continue;
+
+            sent.live = false;
+            Acknowledge(sent.channel, sent.order, seq, now);
+        }
+    }
+
+    void Acknowledge(uint8_t channel, uint16_t order, uint16_t seq, Clock::time_point now)
+    {
+        SendChannel& out = m_send[channel];
+        const size_t index = static_cast<uint16_t>(order - out.firstOrder);
+        if (index >= out.messages.size())
+            return;
+
+        Message& message = out.messages[index];
+        if (message.acked)
+            return;
+
+        // Seq propre a chaque envoi : l'echantillon ne confond jamais deux transmissions (Karn)
+        if (message.seq == seq)
+            SampleRtt(now - message.sentAt);
+
+        message.acked = true;
+        if (--m_inFlight == 0)
+            m_nextDeadline = Clock::time_point::max();
+
+        while (!out.messages.empty() && out.messages.front().acked)
+        {
+            out.messages.pop_front();
+            ++out.firstOrder;
+        }
+    }
+
+    void SampleRtt(Clock::duration sample)
+    {
+        if (!m_hasRtt)
+        {
+            m_srtt = sample;
+            m_rttVar = sample / 2;
+            m_hasRtt = true;
+        }
+        else
+        {
+            const Clock::duration error = sample > m_srtt ? sample - m_srtt : m_srtt - sample;
+            m_rttVar = (m_rttVar * 3 + error) / 4;
+            m_srtt = (m_srtt * 7 + sample) / 8;
+        }
+
+        m_rto = std::clamp<Clock::duration>(m_srtt + m_rttVar * 4, MinRto, MaxRto);
+    }
+
+    void MarkReceived(uint16_t seq)
+    {
+        m_ackPending = true;
+
+        if (!m_hasReceived)
+        {
+            m_hasReceived = true;
+            m_remoteSeq = seq;
+            m_receivedBits = 0;
+            return;
+        }
+
+        if (Reliable::SeqNewer(seq, m_remoteSeq))
+        {
+            const uint16_t shift = static_cast<uint16_t>(seq - m_remoteSeq);
+            m_receivedBits = shift > 32 ? 0 : shift == 32 ? 1u << 31 : (m_receivedBits << shift) | (1u << (shift - 1));
+            m_remoteSeq = seq;
+        }
+        else
+        {
+            const uint16_t back = static_cast<uint16_t>(m_remoteSeq - seq);
+            if (back >= 1 && back <= 32)
+                m_receivedBits |= 1u << (back - 1);
+        }
+    }
+
+    // --- Emission ---
+    SendChannel m_send[ChannelCount];
+    std::array<SentFrame, 256> m_sent;
+    uint16_t m_nextSeq = 0;
+    int m_inFlight = 0;
+    Clock::time_point m_nextDeadline = Clock::time_point::max();
+
+    Clock::duration m_srtt = Clock::duration::zero();
+    Clock::duration m_rttVar = Clock::duration::zero();
+    Clock::duration m_rto = InitialRto;
+    bool m_hasRtt = false;
+
+    // --- Reception ---
+    ReceiveChannel m_receive[ChannelCount];
+    uint16_t m_remoteSeq = 0;
+    uint32_t m_receivedBits = 0;
+    bool m_hasReceived = false;
+    bool m_ackPending = false;
+
+    ReliableStats m_stats;
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <utility>
+
+
+// ==== Files bornees sans verrou ====
+// Capacite arrondie a la puissance de 2 superieure. TryPush() rend false quand la file
+// est pleine : c'est a l'appelant de decider (abandonner et compter, ou reessayer).
+
+constexpr size_t CacheLineSize = 64;
+
+
+// ---- Un producteur, un consommateur ----
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+        : m_capacity(std::bit_ceil(capacity < 2 ? size_t(2) : capacity)), m_mask(m_capacity - 1), m_slots(std::make_unique<T[]>(m_capacity))
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Thread producteur uniquement
+    bool TryPush(T&& item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead >= m_capacity)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead >= m_capacity)
+                return false;
+        }
+
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Thread consommateur uniquement
+    bool TryPop(T& out)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return false;
+        }
+
+        out = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t Capacity() const { return m_capacity; }
+
+    // Approximatif si appele pendant que l'autre thread travaille
+    size_t Size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+private:
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<T[]> m_slots;
+
+    // Chaque cote sur sa propre ligne de cache, avec une copie locale de l'index adverse
+    alignas(CacheLineSize) std::atomic<size_t> m_head{ 0 };
+    size_t m_cachedTail = 0;
+
+    alignas(CacheLineSize) std::atomic<size_t> m_tail{ 0 };
+    size_t m_cachedHead = 0;
+};
+
@@ -0,0 +1,135 @@
+#pragma once
+
+// ==== Couche socket multi-plateforme ====
+// Winsock sous Windows, sockets BSD ailleurs. Le reste du code garde les noms
+// Winsock (SOCKET, INVALID_SOCKET, SOCKET_ERROR) et passe par Net:: pour le reste.
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+
+    #pragma comment(lib, "ws2_32.lib")
+
+    using SocketLen = int;
+#else
+    #include <sys/types.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <netdb.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <cerrno>
+
+    using SOCKET = int;
+    constexpr SOCKET INVALID_SOCKET = -1;
+    constexpr int SOCKET_ERROR = -1;
+
+    using SocketLen = socklen_t;
+#endif
+
+
+namespace Net
+{
+    inline bool Startup()
+    {
+#ifdef _WIN32
+        WSADATA wsaData;
+        return WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+#else
+        return true;
+#endif
+    }
+
+    inline void Cleanup()
+    {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    inline void CloseSocket(SOCKET socket)
+    {
+#ifdef _WIN32
+        closesocket(socket);
+#else
+        close(socket);
+#endif
+    }
+
+    inline int LastError()
+    {
+#ifdef _WIN32
+        return WSAGetLastError();
+#else
+        return errno;
+#endif
+    }
+
+    // Vrai si l'erreur signifie juste "plus rien a lire / ecrire pour l'instant"
+    inline bool IsWouldBlock(int error)
+    {
+#ifdef _WIN32
+        return error == WSAEWOULDBLOCK;
+#else
+        return error == EAGAIN || error == EWOULDBLOCK;
+#endif
+    }
+
+    // Vrai si le datagramme recu depassait le tampon (Winsock le signale en erreur, pas en taille)
+    inline bool IsMessageTooLong(int error)
+    {
+#ifdef _WIN32
+        return error == WSAEMSGSIZE;
+#else
+        return error == EMSGSIZE;
+#endif
+    }
+
+    inline bool SetNonBlocking(SOCKET socket)
+    {
+#ifdef _WIN32
+        u_long mode = 1;
+        return ioctlsocket(socket, FIONBIO, &mode) == 0;
+#else
+        int flags = fcntl(socket, F_GETFL, 0);
+        return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    }
+
+    // Attend que le tampon d'envoi ait de la place (socket non bloquant). false a l'expiration.
+    inline bool WaitWritable(SOCKET socket, int milliseconds)
+    {
+#ifdef _WIN32
+        WSAPOLLFD fd = {};
+        fd.fd = socket;
+        fd.events = POLLOUT;
+        return WSAPoll(&fd, 1, milliseconds) > 0;
+#else
+        pollfd fd = {};
+        fd.fd = socket;
+        fd.events = POLLOUT;
+        int result;
+        do
+        {
+            result = poll(&fd, 1, milliseconds);
+        } while (result < 0 && errno == EINTR);
+        return result > 0;
+#endif
+    }
+
+    inline bool SetReceiveTimeout(SOCKET socket, int milliseconds)
+    {
+#ifdef _WIN32
+        DWORD timeout = static_cast<DWORD>(milliseconds);
+        return setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)) == 0;
+#else
+        timeval timeout;
+        timeout.tv_sec = milliseconds / 1000;
+        timeout.tv_usec = (milliseconds % 1000) * 1000;
+        return setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0;
+#endif
+    }
+}
@@ -1,13 +1,81 @@
 #include "Core/GameServer.h"
 
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <algorithm>
+#include <thread>
+#include <iostream>
+
+
+static void PrintUsage(const char* program)
+{
+    std::cerr << "Usage : " << program << " [options]\n"
+              << "  --recv-workers <n> : threads de reception SO_REUSEPORT (1 a nombre de coeurs)\n"
+              << "  --recv-batch <n>   : datagrammes par appel systeme (1 a 1024)\n"
+              << "  --io-uring         : backend io_uring (Linux), repli automatique sinon\n"
+              << "  --no-rate-limit    : desactive les seaux a jetons par client\n"
+              << "  --room-workers <n> : threads des salles de jeu (0 = la moitie des coeurs)\n"
+              << "  --match-size <n>   : joueurs par salle formee par /queue (2 a 64, defaut : 4)\n";
+}
+
+// Nombre entier (sans reste), ramene dans [min, max]. false si ce n'est pas un nombre.
+static bool ParseInt(std::string_view text, int min, int max, int& out)
+{
+    int value = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error == std::errc::result_out_of_range)
+        value = text.starts_with('-') ? min : max;
+    else if (error != std::errc() || end != text.data() + text.size())
+        return false;
+
+    out = std::clamp(value, min, max);
+    return true;
+}
+
 
 int main(int argc, char** argv)
 {
+    NetworkServerConfig networkConfig;
+    int roomWorkers = 0;
+    MatchmakingConfig matchmaking;
+
+    const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        bool valid = true;
+
+        if (arg == "--recv-workers" && hasValue)
+            valid = ParseInt(argv[++i], 1, cores, networkConfig.receiveWorkers);
+        else if (arg == "--recv-batch" && hasValue)
+            valid = ParseInt(argv[++i], 1, 1024, networkConfig.receiveBatchSize);
+        else if (arg == "--io-uring")
+            networkConfig.backend = NetworkBackend::IoUring;
+        else if (arg == "--no-rate-limit")
+            networkConfig.rateLimits.enabled = false;
+        else if (arg == "--room-workers" && hasValue)
+            valid = ParseInt(argv[++i], 0, cores, roomWorkers);
+        else if (arg == "--match-size" && hasValue)
+            valid = ParseInt(argv[++i], 2, 64, matchmaking.roomSize);
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            std::cerr << "Option invalide : " << argv[i] << "\n";
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
     GameServer server;
-    if (server.Initialize())
+    if (server.Initialize(networkConfig, roomWorkers, matchmaking))
     {
         server.Run();
     }
-    
+
     return 0;
 }
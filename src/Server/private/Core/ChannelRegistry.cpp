@@ -0,0 +1,156 @@
+#include "Core/ChannelRegistry.h"
+
+#include <algorithm>
+
+
+uint16_t ChannelRegistry::AddDefault(std::string_view name)
+{
+    ChatChannel* channel = Create(name);
+    if (!channel)
+        return 0;
+
+    channel->isDefault = true;
+    m_defaults.push_back(channel->id);
+    return channel->id;
+}
+
+ChannelRegistry::JoinResult ChannelRegistry::Join(PlayerInfo& player, std::string_view name, uint16_t* channelId)
+{
+    if (!IsValidName(name))
+        return JoinResult::InvalidName;
+
+    return JoinChecked(player, name, channelId);
+}
+
+ChannelRegistry::JoinResult ChannelRegistry::JoinReserved(PlayerInfo& player, std::string_view name, uint16_t* channelId)
+{
+    if (name.empty() || name.size() > MaxNameLength || IsValidName(name))
+        return JoinResult::InvalidName;
+
+    return JoinChecked(player, name, channelId);
+}
+
+ChannelRegistry::JoinResult ChannelRegistry::JoinChecked(PlayerInfo& player, std::string_view name, uint16_t* channelId)
+{
+    const uint16_t existingId = static_cast<uint16_t>(m_names.FindId(name));
+    if (existingId != 0 && IsMember(player, existingId))
+    {
+        if (channelId)
+            *channelId = existingId;
+        return JoinResult::AlreadyMember;
+    }
+
+    if (player.channels.size() >= MaxChannelsPerPlayer)
+        return JoinResult::TooManyChannels;
+
+    ChatChannel* channel = existingId != 0 ? &m_channels[existingId] : Create(name);
+    if (!channel)
+        return JoinResult::Full;
+
+    channel->members.push_back(player.handle);
+    player.channels.push_back(channel->id);
+
+    if (channelId)
+        *channelId = channel->id;
+    return JoinResult::Joined;
+}
+
+void ChannelRegistry::JoinDefaults(PlayerInfo& player)
+{
+    for (uint16_t id : m_defaults)
+    {
+        Join(player, m_channels[id].name);
+    }
+}
+
+bool ChannelRegistry::Leave(PlayerInfo& player, uint16_t channelId)
+{
+    auto membership = std::find(player.channels.begin(), player.channels.end(), channelId);
+    if (membership == player.channels.end())
+        return false;
+
+    // Ordre sans importance des deux cotes : retrait par echange avec le dernier
+    *membership = player.channels.back();
+    player.channels.pop_back();
+
+    ChatChannel& channel = m_channels[channelId];
+    auto member = std::find(channel.members.begin(), channel.members.end(), player.handle);
+    if (member != channel.members.end())
+    {
+        *member = channel.members.back();
+        channel.members.pop_back();
+    }
+
+    if (channel.members.empty() && !channel.isDefault)
+    {
+        m_names.Erase(channel.id);
+        channel = ChatChannel();
+    }
+
+    return true;
+}
+
+void ChannelRegistry::LeaveAll(PlayerInfo& player)
+{
+    while (!player.channels.empty())
+    {
+        Leave(player, player.channels.back());
+    }
+}
+
+const ChatChannel* ChannelRegistry::Find(uint16_t channelId) const
+{
+    return channelId != 0 && channelId < m_channels.size() && m_channels[channelId].id == channelId ? &m_channels[channelId] : nullptr;
+}
+
+const ChatChannel* ChannelRegistry::Find(std::string_view name) const
+{
+    return Find(static_cast<uint16_t>(m_names.FindId(name)));
+}
+
+bool ChannelRegistry::IsMember(const PlayerInfo& player, uint16_t channelId) const
+{
+    return std::find(player.channels.begin(), player.channels.end(), channelId) != player.channels.end();
+}
+
+bool ChannelRegistry::IsValidName(std::string_view name)
+{
+    if (name.empty() || name.size() > MaxNameLength)
+        return false;
+
+    return std::all_of(name.begin(), name.end(), [](char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-';
+    });
+}
+
+ChatChannel* ChannelRegistry::Create(std::string_view name)
+{
+    const uint16_t id = NextFreeId();
+    if (id == 0)
+        return nullptr;
+
+    if (m_channels.size() <= id)
+        m_channels.resize(static_cast<size_t>(id) + 1);
+
+    ChatChannel& channel = m_channels[id];
+    channel.id = id;
+    channel.name.assign(name);
+    m_names.Set(id, name);
+    return &channel;
+}
+
+uint16_t ChannelRegistry::NextFreeId()
+{
+    // Tourne sur tout l'espace avant de revenir a un id libere
+    for (uint32_t attempt = 0; attempt < NameTable::MaxId; ++attempt)
+    {
+        const uint16_t id = m_nextId;
+        m_nextId = m_nextId >= NameTable::MaxId ? 1 : static_cast<uint16_t>(m_nextId + 1);
+
+        if (id >= m_channels.size() || m_channels[id].id == 0)
+            return id;
+    }
+
+    return 0;
+}
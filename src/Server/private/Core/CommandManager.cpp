@@ -18,13 +18,13 @@ void CommandManager::RegisterCommand(const std::string& command, CommandHandler
     m_commands[cmdLower] = handler;
 }
 
-bool CommandManager::ProcessCommand(PlayerInfo* player, const std::string& message)
+bool CommandManager::ProcessCommand(PlayerInfo* player, std::string_view message)
 {
     if (message.empty() || message[0] != '/')
         return false;
 
     // Découper la commande
-    std::string cleanMsg = message.substr(1);
+    std::string cleanMsg(message.substr(1));
     std::stringstream ss(cleanMsg);
     std::string command;
     ss >> command;
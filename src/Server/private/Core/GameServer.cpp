@@ -2,32 +2,39 @@
 #include "Systems/AuthenticationSystem.h"
 #include "Systems/ChatSystem.h"
 #include "Systems/MiniGameSystem.h"
+#include "Systems/MatchmakingSystem.h"
 
 #include "NetworkCommon.h"
 #include "PacketSystem.h"
 
 #include <iostream>
 #include <algorithm>
-#include <thread>
 #include <chrono>
 
 
 GameServer::GameServer() : m_commandManager(this)
 {
+    // Canaux permanents (ids 1, 2, 3), un onglet chacun cote client
+    m_channels.AddDefault("Global");
+    m_channels.AddDefault("System");
+    m_channels.AddDefault("Game");
 }
 
 GameServer::~GameServer()
 {
 }
 
-bool GameServer::Initialize()
+bool GameServer::Initialize(const NetworkServerConfig& networkConfig, int roomWorkers, const MatchmakingConfig& matchmaking)
 {
-    if (!m_network.Start(PORT))
+    if (!m_network.Start(PORT, networkConfig))
         return false;
 
     AddSystem<AuthenticationSystem>()->Init(this);
     AddSystem<ChatSystem>()->Init(this);
-    AddSystem<MiniGameSystem>()->Init(this);
+
+    MiniGameSystem* games = AddSystem<MiniGameSystem>(roomWorkers);
+    games->Init(this);
+    AddSystem<MatchmakingSystem>(games, matchmaking)->Init(this);
     
     return true;
 }
@@ -45,63 +52,115 @@ void GameServer::Run()
         lastTime = now;
 
         m_network.PollEvents();
+        m_timers.Advance(now);
         
         for (auto& sys : m_systems)
         {
             sys->Update(dt);
         }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // Tout ce que les handlers et les systemes ont produit part en quelques appels systeme
+        m_network.FlushSends();
+
+        // Dort jusqu'au prochain paquet, minuteur ou echeance d'un systeme
+        auto deadline = std::min(m_timers.NextDeadline(), m_network.NextReliableDeadline());
+        for (auto& sys : m_systems)
+        {
+            deadline = std::min(deadline, sys->GetNextDeadline());
+        }
+
+        m_network.WaitForPackets(deadline);
     }
 }
 
 
 PlayerInfo* GameServer::GetPlayerByAddr(const sockaddr_in& addr)
 {
-    for (auto& p : m_players)
+    return m_players.Find(addr);
+}
+
+PlayerInfo* GameServer::GetPlayerByPseudo(std::string_view pseudo)
+{
+    return m_players.FindByPseudo(pseudo);
+}
+
+void GameServer::NotifyPlayerConnected(PlayerHandle handle)
+{
+    for (auto& sys : m_systems)
     {
-        if (p.address.sin_addr.s_addr == addr.sin_addr.s_addr && p.address.sin_port == addr.sin_port)
-        {
-            return &p;
-        }
+        // Un systeme a pu retirer le joueur : on repasse par le handle
+        PlayerInfo* player = m_players.Get(handle);
+        if (!player)
+            return;
+
+        sys->OnPlayerConnect(player);
     }
-    
-    return nullptr;
 }
 
 void GameServer::RemovePlayer(const sockaddr_in& addr)
 {
-    auto it = std::find_if(m_players.begin(), m_players.end(), [&](const PlayerInfo& p) 
-        {
-            return p.address.sin_addr.s_addr == addr.sin_addr.s_addr && p.address.sin_port == addr.sin_port;
-        });
+    PlayerInfo* player = m_players.Find(addr);
+    if (player)
+    {
+        RemovePlayer(player->handle);
+    }
+}
 
-    if (it != m_players.end())
+void GameServer::RemovePlayer(PlayerHandle handle)
+{
+    PlayerInfo* player = m_players.Get(handle);
+    if (player)
     {
-        std::cout << "Deconnexion : " << it->pseudo << std::endl;
-        
+        std::cout << "Deconnexion : " << player->pseudo << std::endl;
+
+        // Le joueur est encore enregistre pendant les notifications
+        for (auto& sys : m_systems)
+        {
+            sys->OnPlayerDisconnect(player);
+        }
+
+        // Un systeme a pu ajouter/retirer des joueurs : on repasse par le handle
+        player = m_players.Get(handle);
+        if (!player)
+            return;
+
         PacketConnectionState leavePkt;
         leavePkt.IsConnected = false;
-        leavePkt.Pseudo = it->pseudo;
-        Broadcast(leavePkt, &addr);
+        leavePkt.Pseudo = player->pseudo;
+        leavePkt.PlayerId = player->id;
         
-        bool wasAdmin = it->isAdmin;
-        m_players.erase(it);
-
-        if (wasAdmin && !m_players.empty())
+        bool wasAdmin = player->isAdmin;
+        m_network.CloseReliable(player->address);
+        m_network.SetBundling(player->address, false);
+        m_network.SetFragmentation(player->address, false);
+        m_channels.LeaveAll(*player);
+        m_players.Remove(handle);
+
+        // Diffuse apres le retrait : le depart porte la version du roster qu'il produit
+        leavePkt.RosterVersion = m_players.GetVersion();
+        Broadcast(leavePkt);
+
+        // Le plus ancien joueur encore present herite du role (parcours complet : seulement si besoin)
+        PlayerInfo* heir = wasAdmin ? m_players.Oldest() : nullptr;
+        if (heir)
         {
-            m_players[0].isAdmin = true;
-            std::cout << "Nouveau ADMIN designe : " << m_players[0].pseudo << std::endl;
+            heir->isAdmin = true;
+            std::cout << "Nouveau ADMIN designe : " << heir->pseudo << std::endl;
 
             PacketChat adminMsg;
             adminMsg.Sender = "SYSTEM";
-            adminMsg.Message = m_players[0].pseudo + " est desormais l'ADMIN.";
+            adminMsg.Message = heir->pseudo + " est desormais l'ADMIN.";
             Broadcast(adminMsg);
         }
     }
 }
 
 void GameServer::Broadcast(const IPacket& pkt, const sockaddr_in* senderToIgnore)
+{
+    BroadcastPerFormat([&pkt](WireFormat format) { return EncodePacket(pkt, format); }, pkt.GetChannel(), senderToIgnore);
+}
+
+void GameServer::Broadcast(const EncodedPacket& pkt, const sockaddr_in* senderToIgnore)
 {
     for (auto& p : m_players)
     {
@@ -113,6 +172,22 @@ void GameServer::Broadcast(const IPacket& pkt, const sockaddr_in* senderToIgnore
 }
 
 void GameServer::SendTo(const sockaddr_in& target, const IPacket& pkt)
+{
+    m_network.SendTo(pkt, target, FormatOf(target));
+}
+
+void GameServer::SendTo(const PlayerInfo& target, const IPacket& pkt)
+{
+    m_network.SendTo(pkt, target.address, target.wireFormat);
+}
+
+WireFormat GameServer::FormatOf(const sockaddr_in& address)
+{
+    PlayerInfo* player = m_players.Find(address);
+    return player ? player->wireFormat : WireFormat::Legacy;
+}
+
+void GameServer::SendTo(const sockaddr_in& target, const EncodedPacket& pkt)
 {
     m_network.SendTo(pkt, target);
 }
@@ -0,0 +1,226 @@
+#include "Core/MatchQueue.h"
+
+#include <algorithm>
+#include <climits>
+
+
+MatchQueue::MatchQueue(const MatchmakingConfig& config) : m_config(config)
+{
+    m_config.roomSize = std::max(m_config.roomSize, 2);
+}
+
+bool MatchQueue::Insert(PlayerHandle player, int rating, std::string_view region, Clock::time_point now)
+{
+    if (!IsValidRegion(region) || m_entries.count(KeyOf(player)) != 0)
+        return false;
+
+    std::unique_ptr<Bucket>& bucket = m_buckets[std::string(region)];
+    if (!bucket)
+    {
+        bucket = std::make_unique<Bucket>();
+        bucket->region.assign(region);
+    }
+
+    Ticket ticket;
+    ticket.rating = rating;
+    ticket.order = m_nextOrder++;
+    ticket.player = player;
+    ticket.queuedAt = now;
+
+    bucket->tickets.insert(ticket);
+    bucket->fresh.push_back(ticket);
+    m_entries.emplace(KeyOf(player), Entry{ bucket.get(), ticket });
+    return true;
+}
+
+bool MatchQueue::Remove(PlayerHandle player)
+{
+    auto it = m_entries.find(KeyOf(player));
+    if (it == m_entries.end())
+        return false;
+
+    // Un ticket encore dans 'fresh' est ignore par Form : il n'est plus dans le seau
+    Bucket* bucket = it->second.bucket;
+    bucket->tickets.erase(it->second.ticket);
+    m_entries.erase(it);
+
+    // Seau vide : rendu aussitot (sinon une region inventee a chaque /queue resterait a vie)
+    if (bucket->tickets.empty())
+        m_buckets.erase(m_buckets.find(bucket->region));
+    return true;
+}
+
+bool MatchQueue::Contains(PlayerHandle player) const
+{
+    return m_entries.count(KeyOf(player)) != 0;
+}
+
+bool MatchQueue::Find(PlayerHandle player, std::string* region, Clock::time_point* queuedAt) const
+{
+    auto it = m_entries.find(KeyOf(player));
+    if (it == m_entries.end())
+        return false;
+
+    if (region)
+        *region = it->second.bucket->region;
+    if (queuedAt)
+        *queuedAt = it->second.ticket.queuedAt;
+    return true;
+}
+
+size_t MatchQueue::Form(Clock::time_point now, std::vector<MatchGroup>& groups)
+{
+    const size_t before = groups.size();
+    const bool sweep = now >= m_nextSweep;
+
+    for (auto it = m_buckets.begin(); it != m_buckets.end();)
+    {
+        Bucket& bucket = *it->second;
+
+        if (sweep)
+        {
+            Sweep(bucket, now, groups);
+        }
+        else
+        {
+            for (const Ticket& ticket : bucket.fresh)
+            {
+                FormAround(bucket, ticket, now, groups);
+            }
+        }
+
+        bucket.fresh.clear();
+
+        // Tous partis en groupes : le seau ne coute plus rien aux ticks suivants
+        if (bucket.tickets.empty())
+            it = m_buckets.erase(it);
+        else
+            ++it;
+    }
+
+    if (sweep)
+        m_nextSweep = now + SweepInterval;
+
+    return groups.size() - before;
+}
+
+MatchQueue::Clock::time_point MatchQueue::NextDeadline() const
+{
+    return m_entries.empty() ? Clock::time_point::max() : m_nextSweep;
+}
+
+bool MatchQueue::IsValidRegion(std::string_view region)
+{
+    if (region.empty() || region.size() > MaxRegionLength)
+        return false;
+
+    return std::all_of(region.begin(), region.end(), [](char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9');
+    });
+}
+
+int MatchQueue::Tolerance(const Ticket& ticket, Clock::time_point now) const
+{
+    const double waited = std::chrono::duration<double>(now - ticket.queuedAt).count();
+    const double tolerance = m_config.baseSpread + m_config.spreadPerSecond * std::max(waited, 0.0);
+    return static_cast<int>(std::min<double>(tolerance, m_config.maxSpread));
+}
+
+bool MatchQueue::Fits(const Bucket& bucket, Iterator first, Clock::time_point now, int* spread) const
+{
+    // L'ecart ne fait que croitre et la tolerance que baisser : on sort au premier depassement
+    int tolerance = INT_MAX;
+
+    Iterator it = first;
+    for (int i = 0; i < m_config.roomSize; ++i, ++it)
+    {
+        if (it == bucket.tickets.end())
+            return false;
+
+        tolerance = std::min(tolerance, Tolerance(*it, now));
+        *spread = it->rating - first->rating;
+        if (*spread > tolerance)
+            return false;
+    }
+
+    return true;
+}
+
+bool MatchQueue::FormAround(Bucket& bucket, const Ticket& ticket, Clock::time_point now, std::vector<MatchGroup>& groups)
+{
+    Iterator it = bucket.tickets.find(ticket);
+    if (it == bucket.tickets.end())
+        return false;
+
+    // Les fenetres qui contiennent 'ticket' commencent au plus roomSize - 1 crans avant lui
+    Iterator first = it;
+    for (int i = 0; i < m_config.roomSize - 1 && first != bucket.tickets.begin(); ++i)
+    {
+        --first;
+    }
+
+    Iterator best = bucket.tickets.end();
+    int bestSpread = INT_MAX;
+    for (Iterator start = first;; ++start)
+    {
+        int spread = 0;
+        if (Fits(bucket, start, now, &spread) && spread < bestSpread)
+        {
+            best = start;
+            bestSpread = spread;
+        }
+
+        if (start == it)
+            break;
+    }
+
+    if (best == bucket.tickets.end())
+        return false;
+
+    Take(bucket, best, groups);
+    return true;
+}
+
+size_t MatchQueue::Sweep(Bucket& bucket, Clock::time_point now, std::vector<MatchGroup>& groups)
+{
+    // Glouton par classement croissant : une fenetre qui tient part, sinon on avance d'un cran
+    size_t formed = 0;
+    Iterator it = bucket.tickets.begin();
+    while (it != bucket.tickets.end())
+    {
+        int spread = 0;
+        if (Fits(bucket, it, now, &spread))
+        {
+            it = Take(bucket, it, groups);
+            ++formed;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    return formed;
+}
+
+MatchQueue::Iterator MatchQueue::Take(Bucket& bucket, Iterator first, std::vector<MatchGroup>& groups)
+{
+    MatchGroup& group = groups.emplace_back();
+    group.region = bucket.region;
+    group.players.reserve(static_cast<size_t>(m_config.roomSize));
+
+    int64_t total = 0;
+    Iterator it = first;
+    for (int i = 0; i < m_config.roomSize; ++i)
+    {
+        group.players.push_back(it->player);
+        total += it->rating;
+
+        m_entries.erase(KeyOf(it->player));
+        it = bucket.tickets.erase(it);
+    }
+
+    group.averageRating = static_cast<int>(total / m_config.roomSize);
+    return it;
+}
@@ -0,0 +1,164 @@
+#include "Core/PlayerRegistry.h"
+
+
+PlayerInfo& PlayerRegistry::Add(const PlayerInfo& player)
+{
+    // Reutilise un slot libre (sa generation a deja ete avancee) ou en cree un
+    uint32_t slotIndex;
+    if (m_freeSlot != PlayerHandle::InvalidIndex)
+    {
+        slotIndex = m_freeSlot;
+        m_freeSlot = m_slots[slotIndex].dense;
+    }
+    else
+    {
+        slotIndex = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    slot.dense = static_cast<uint32_t>(m_players.size());
+
+    m_players.push_back(player);
+
+    PlayerInfo& added = m_players.back();
+    added.handle = { slotIndex, slot.generation };
+    added.joinOrder = m_nextJoinOrder++;
+
+    // Id de session = slot + 1 : dense, reutilise apres depart (annonce a nouveau avec le nouveau pseudo)
+    added.id = slotIndex < 0xFFFFu ? static_cast<uint16_t>(slotIndex + 1) : 0;
+
+    m_byAddress[MakeKey(added.address)] = added.handle;
+    m_byPseudo.emplace(added.pseudo, added.handle);
+    ++m_version;
+    return added;
+}
+
+bool PlayerRegistry::Remove(PlayerHandle handle)
+{
+    PlayerInfo* player = Get(handle);
+    if (!player)
+        return false;
+
+    m_byAddress.erase(MakeKey(player->address));
+    UnindexPseudo(player->pseudo, handle);
+
+    // Le dernier joueur prend la place libre : seul son slot change, ses handles restent valides
+    Slot& slot = m_slots[handle.index];
+    uint32_t dense = slot.dense;
+    uint32_t last = static_cast<uint32_t>(m_players.size() - 1);
+
+    if (dense != last)
+    {
+        m_players[dense] = std::move(m_players[last]);
+        m_slots[m_players[dense].handle.index].dense = dense;
+    }
+
+    m_players.pop_back();
+
+    ++slot.generation;
+    slot.dense = m_freeSlot;
+    m_freeSlot = handle.index;
+    ++m_version;
+    return true;
+}
+
+bool PlayerRegistry::Remove(const sockaddr_in& address)
+{
+    auto it = m_byAddress.find(MakeKey(address));
+    if (it == m_byAddress.end())
+        return false;
+
+    return Remove(it->second);
+}
+
+void PlayerRegistry::Clear()
+{
+    while (!m_players.empty())
+    {
+        Remove(m_players.back().handle);
+    }
+}
+
+PlayerInfo* PlayerRegistry::Get(PlayerHandle handle)
+{
+    return IsAlive(handle) ? &m_players[m_slots[handle.index].dense] : nullptr;
+}
+
+bool PlayerRegistry::IsAlive(PlayerHandle handle) const
+{
+    // Un slot libere a deja change de generation : un ancien handle ne correspond plus
+    return handle.index < m_slots.size() && m_slots[handle.index].generation == handle.generation;
+}
+
+PlayerInfo* PlayerRegistry::Find(const sockaddr_in& address)
+{
+    auto it = m_byAddress.find(MakeKey(address));
+    return it != m_byAddress.end() ? Get(it->second) : nullptr;
+}
+
+PlayerInfo* PlayerRegistry::FindByPseudo(std::string_view pseudo)
+{
+    auto range = m_byPseudo.equal_range(pseudo);
+
+    PlayerInfo* found = nullptr;
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        PlayerInfo* candidate = Get(it->second);
+        if (candidate && (found == nullptr || candidate->joinOrder < found->joinOrder))
+            found = candidate;
+    }
+
+    return found;
+}
+
+PlayerInfo* PlayerRegistry::FindById(uint32_t id)
+{
+    if (id == 0 || id > m_slots.size())
+        return nullptr;
+
+    const uint32_t slotIndex = id - 1;
+    const uint32_t dense = m_slots[slotIndex].dense;
+
+    // Un slot libre garde dans 'dense' le slot libre suivant : on verifie l'occupant
+    if (dense < m_players.size() && m_players[dense].handle.index == slotIndex)
+        return &m_players[dense];
+
+    return nullptr;
+}
+
+void PlayerRegistry::Rename(PlayerInfo& player, const std::string& pseudo)
+{
+    if (player.pseudo == pseudo)
+        return;
+
+    UnindexPseudo(player.pseudo, player.handle);
+    player.pseudo = pseudo;
+    m_byPseudo.emplace(player.pseudo, player.handle);
+    ++m_version;
+}
+
+PlayerInfo* PlayerRegistry::Oldest()
+{
+    PlayerInfo* oldest = nullptr;
+    for (auto& p : m_players)
+    {
+        if (oldest == nullptr || p.joinOrder < oldest->joinOrder)
+            oldest = &p;
+    }
+
+    return oldest;
+}
+
+void PlayerRegistry::UnindexPseudo(const std::string& pseudo, PlayerHandle handle)
+{
+    auto range = m_byPseudo.equal_range(pseudo);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == handle)
+        {
+            m_byPseudo.erase(it);
+            return;
+        }
+    }
+}
@@ -0,0 +1,226 @@
+#include "Core/TimerWheel.h"
+
+#include <algorithm>
+#include <bit>
+
+
+TimerWheel::TimerWheel() : m_origin(Clock::now())
+{
+    std::fill(std::begin(m_slots), std::end(m_slots), None);
+}
+
+TimerHandle TimerWheel::Schedule(Clock::time_point when, Callback callback)
+{
+    uint32_t index;
+    if (m_freeTimer != None)
+    {
+        index = m_freeTimer;
+        m_freeTimer = m_timers[index].next;
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_timers.size());
+        m_timers.emplace_back();
+    }
+
+    Timer& timer = m_timers[index];
+    timer.when = when;
+    timer.callback = std::move(callback);
+    timer.active = true;
+    ++m_activeCount;
+
+    Insert(index, m_currentTick + 1);
+    return { index, timer.generation };
+}
+
+bool TimerWheel::Reschedule(TimerHandle handle, Clock::time_point when)
+{
+    if (!IsActive(handle))
+        return false;
+
+    Unlink(handle.index);
+    m_timers[handle.index].when = when;
+    Insert(handle.index, m_currentTick + 1);
+    return true;
+}
+
+bool TimerWheel::Cancel(TimerHandle handle)
+{
+    if (!IsActive(handle))
+        return false;
+
+    Unlink(handle.index);
+    Release(handle.index);
+    return true;
+}
+
+bool TimerWheel::IsActive(TimerHandle handle) const
+{
+    return handle.index < m_timers.size() && m_timers[handle.index].generation == handle.generation && m_timers[handle.index].active;
+}
+
+void TimerWheel::Advance(Clock::time_point now)
+{
+    uint64_t nowTick = now > m_origin ? static_cast<uint64_t>((now - m_origin) / TickDuration) : 0;
+
+    // Roue vide : rien a cascader, on saute directement
+    if (m_activeCount == 0)
+    {
+        m_currentTick = std::max(m_currentTick, nowTick);
+        return;
+    }
+
+    while (m_currentTick < nowTick)
+    {
+        ProcessTick(m_currentTick + 1);
+
+        if (m_activeCount == 0)
+            m_currentTick = nowTick;
+    }
+}
+
+TimerWheel::Clock::time_point TimerWheel::NextDeadline() const
+{
+    if (m_activeCount == 0)
+        return Clock::time_point::max();
+
+    // Pour chaque niveau : prochaine case occupee apres la position courante.
+    // Au niveau 0 c'est une echeance ; plus haut, l'instant de la cascade.
+    uint64_t nextTick = UINT64_MAX;
+    for (int level = 0; level < LevelCount; ++level)
+    {
+        if (m_occupied[level] == 0)
+            continue;
+
+        const int shift = level * LevelBits;
+        const uint64_t base = m_currentTick >> shift;
+        const int start = static_cast<int>((base + 1) & (SlotsPerLevel - 1));
+
+        uint64_t offset = static_cast<uint64_t>(std::countr_zero(std::rotr(m_occupied[level], start))) + 1;
+        nextTick = std::min(nextTick, (base + offset) << shift);
+    }
+
+    return m_origin + TickDuration * static_cast<int64_t>(nextTick);
+}
+
+uint64_t TimerWheel::TickOf(Clock::time_point when) const
+{
+    // Arrondi superieur : un minuteur ne part jamais avant son echeance
+    if (when <= m_origin)
+        return 0;
+
+    return static_cast<uint64_t>((when - m_origin + TickDuration - Clock::duration(1)) / TickDuration);
+}
+
+void TimerWheel::Insert(uint32_t index, uint64_t minTick)
+{
+    Timer& timer = m_timers[index];
+
+    // Deja echu : part a minTick (le prochain tick, ou le tick en cours pendant une cascade)
+    timer.expiryTick = std::max(TickOf(timer.when), minTick);
+
+    // Trop loin pour la roue : range au plus haut niveau, replanifie a l'expiration
+    constexpr uint64_t Span = uint64_t(1) << (LevelBits * LevelCount);
+    uint64_t tick = std::min(timer.expiryTick, m_currentTick + Span - 1);
+    uint64_t delta = tick - m_currentTick;
+
+    int level = 0;
+    while (level < LevelCount - 1 && delta >= (uint64_t(1) << (LevelBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    const int slotIndex = static_cast<int>((tick >> (level * LevelBits)) & (SlotsPerLevel - 1));
+    timer.slot = static_cast<uint16_t>(level * SlotsPerLevel + slotIndex);
+
+    uint32_t& head = m_slots[timer.slot];
+    timer.prev = None;
+    timer.next = head;
+    if (head != None)
+        m_timers[head].prev = index;
+    head = index;
+
+    m_occupied[level] |= uint64_t(1) << slotIndex;
+}
+
+void TimerWheel::Unlink(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+
+    if (timer.prev != None)
+        m_timers[timer.prev].next = timer.next;
+    else
+        m_slots[timer.slot] = timer.next;
+
+    if (timer.next != None)
+        m_timers[timer.next].prev = timer.prev;
+
+    if (m_slots[timer.slot] == None)
+        m_occupied[timer.slot / SlotsPerLevel] &= ~(uint64_t(1) << (timer.slot % SlotsPerLevel));
+
+    timer.prev = None;
+    timer.next = None;
+}
+
+void TimerWheel::Release(uint32_t index)
+{
+    Timer& timer = m_timers[index];
+    timer.active = false;
+    timer.callback = nullptr;
+    ++timer.generation;
+
+    timer.next = m_freeTimer;
+    m_freeTimer = index;
+    --m_activeCount;
+}
+
+void TimerWheel::Cascade(int level, uint64_t tick)
+{
+    const uint16_t slot = static_cast<uint16_t>(level * SlotsPerLevel + ((tick >> (level * LevelBits)) & (SlotsPerLevel - 1)));
+
+    // Les minuteurs de la case redescendent selon leur echeance
+    uint32_t index = m_slots[slot];
+    m_slots[slot] = None;
+    m_occupied[level] &= ~(uint64_t(1) << (slot % SlotsPerLevel));
+
+    while (index != None)
+    {
+        uint32_t next = m_timers[index].next;
+        Insert(index, tick);
+        index = next;
+    }
+}
+
+void TimerWheel::ProcessTick(uint64_t tick)
+{
+    // Cascades du plus haut niveau vers le bas : un minuteur peut descendre de plusieurs niveaux
+    // dans le meme tick. Une echeance egale a 'tick' retombe dans la case traitee juste apres.
+    m_currentTick = tick;
+
+    for (int level = LevelCount - 1; level > 0; --level)
+    {
+        if ((tick & ((uint64_t(1) << (level * LevelBits)) - 1)) == 0)
+            Cascade(level, tick);
+    }
+
+    const uint16_t slot = static_cast<uint16_t>(tick & (SlotsPerLevel - 1));
+    while (m_slots[slot] != None)
+    {
+        uint32_t index = m_slots[slot];
+        Unlink(index);
+
+        Timer& timer = m_timers[index];
+
+        // Range au plus haut niveau faute de place : pas encore son heure
+        if (timer.expiryTick > tick)
+        {
+            Insert(index, tick + 1);
+            continue;
+        }
+
+        Callback callback = std::move(timer.callback);
+        Release(index);
+
+        callback();
+    }
+}
@@ -2,11 +2,96 @@
 
 #include "NetworkCommon.h"
 #include "PacketSystem.h"
+#include "PacketBundle.h"
+#include "FragmentAssembler.h"
 
 #include <iostream>
+#include <algorithm>
+#include <bit>
+#include <cstring>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
 
-NetworkServer::NetworkServer() : m_socket(INVALID_SOCKET), m_isRunning(false)
+
+static_assert(static_cast<int>(ReliableChannel::Game) < ReliableEndpoint::ChannelCount, "Chaque ReliableChannel doit avoir son canal dans ReliableEndpoint.");
+
+
+// ==== Tampons pre-alloues pour la reception par lots ====
+struct NetworkServer::ReceiveBatch
+{
+    explicit ReceiveBatch(int size) : buffers(static_cast<size_t>(size) * MAX_PACKET_SIZE), senders(size), lengths(size, 0)
+#ifdef __linux__
+        , iovecs(size), headers(size)
+#endif
+    {
+#ifdef __linux__
+        // Les iovec/mmsghdr pointent une fois pour toutes sur les tampons : rien a refaire par appel
+        for (int i = 0; i < size; ++i)
+        {
+            iovecs[i].iov_base = &buffers[static_cast<size_t>(i) * MAX_PACKET_SIZE];
+            iovecs[i].iov_len = MAX_PACKET_SIZE;
+
+            headers[i] = {};
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &senders[i];
+        }
+#endif
+    }
+
+    const char* Buffer(int index) const
+    {
+        return &buffers[static_cast<size_t>(index) * MAX_PACKET_SIZE];
+    }
+
+    char* Buffer(int index)
+    {
+        return &buffers[static_cast<size_t>(index) * MAX_PACKET_SIZE];
+    }
+
+    int Size() const
+    {
+        return static_cast<int>(senders.size());
+    }
+
+    std::vector<char> buffers;
+    std::vector<sockaddr_in> senders;
+    std::vector<int> lengths;
+
+#ifdef __linux__
+    std::vector<iovec> iovecs;
+    std::vector<mmsghdr> headers;
+#endif
+};
+
+
+// ==== En-tetes pre-alloues pour l'envoi par lots ====
+struct NetworkServer::SendBatch
+{
+    explicit SendBatch(int size)
+#ifdef __linux__
+        : iovecs(size), headers(size)
+#endif
+    {
+    }
+
+#ifdef __linux__
+    std::vector<iovec> iovecs;
+    std::vector<mmsghdr> headers;
+#endif
+};
+
+
+NetworkServer::ReceiveShard::ReceiveShard(size_t queueCapacity) : packetQueue(queueCapacity)
+{
+}
+
+NetworkServer::ReceiveShard::~ReceiveShard() = default;
+
+
+NetworkServer::NetworkServer() : m_socket(INVALID_SOCKET), m_serverAddr{}, m_isRunning(false)
 {
 }
 
@@ -15,20 +100,34 @@ NetworkServer::~NetworkServer()
     Stop();
 }
 
-bool NetworkServer::Start(unsigned short port)
+bool NetworkServer::Start(unsigned short port, const NetworkServerConfig& config)
 {
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    m_config = config;
+    m_config.receiveBatchSize = std::max(1, m_config.receiveBatchSize);
+    m_config.receiveWorkers = std::max(1, m_config.receiveWorkers);
+    m_config.receiveQueueCapacity = std::max(2, m_config.receiveQueueCapacity);
+    m_config.sendBatchSize = std::max(1, m_config.sendBatchSize);
+
+    m_sendBatch = std::make_unique<SendBatch>(m_config.sendBatchSize);
+    m_outbound.reserve(static_cast<size_t>(m_config.sendBatchSize) * 4);
+
+#ifndef __linux__
+    if (m_config.receiveWorkers > 1)
     {
-        std::cerr << "WSAStartup failed\n";
+        std::cout << "SO_REUSEPORT sharding indisponible sur cette plateforme : 1 worker de reception.\n";
+        m_config.receiveWorkers = 1;
+    }
+#endif
+
+    if (!Net::Startup())
+    {
+        std::cerr << "Socket startup failed\n";
         return false;
     }
 
-    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
-    if (m_socket == INVALID_SOCKET)
+    if (!m_gameWakeup.Open())
     {
-        std::cerr << "Socket creation failed: " << WSAGetLastError() << "\n";
-        WSACleanup();
+        Net::Cleanup();
         return false;
     }
 
@@ -36,36 +135,176 @@ bool NetworkServer::Start(unsigned short port)
     m_serverAddr.sin_port = htons(port);
     m_serverAddr.sin_addr.s_addr = INADDR_ANY;
 
-    if (bind(m_socket, reinterpret_cast<sockaddr*>(&m_serverAddr), sizeof(m_serverAddr)) == SOCKET_ERROR)
+    if (m_config.backend == NetworkBackend::IoUring)
     {
-        std::cerr << "Bind failed: " << WSAGetLastError() << "\n";
-        closesocket(m_socket);
-        WSACleanup();
-        return false;
+        if (StartIoUring())
+        {
+            m_isRunning = true;
+            std::cout << "NetworkServer started on port " << port << " (io_uring)\n";
+            return true;
+        }
+
+        std::cout << "io_uring indisponible : repli sur les workers de reception.\n";
+    }
+
+    bool reusePort = m_config.receiveWorkers > 1;
+    for (int i = 0; i < m_config.receiveWorkers; ++i)
+    {
+        auto shard = std::make_unique<ReceiveShard>(static_cast<size_t>(m_config.receiveQueueCapacity));
+        if (!OpenShard(*shard, reusePort))
+        {
+            if (shard->socket != INVALID_SOCKET)
+                Net::CloseSocket(shard->socket);
+
+            CloseShards();
+            m_gameWakeup.Close();
+            Net::Cleanup();
+            return false;
+        }
+
+        m_shards.push_back(std::move(shard));
     }
 
+    m_socket = m_shards.front()->socket;
     m_isRunning = true;
-    m_receiveThread = std::thread(&NetworkServer::ReceiveLoop, this);
 
-    std::cout << "NetworkServer started on port " << port << "\n";
+    for (auto& shard : m_shards)
+    {
+        shard->thread = std::thread(&NetworkServer::ReceiveLoop, this, std::ref(*shard));
+    }
+
+    std::cout << "NetworkServer started on port " << port << " (" << m_shards.size() << " receive worker(s))\n";
+    return true;
+}
+
+bool NetworkServer::StartIoUring()
+{
+    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_socket == INVALID_SOCKET)
+        return false;
+
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&m_serverAddr), sizeof(m_serverAddr)) == SOCKET_ERROR || !Net::SetNonBlocking(m_socket))
+    {
+        std::cerr << "Bind failed: " << Net::LastError() << "\n";
+        Net::CloseSocket(m_socket);
+        m_socket = INVALID_SOCKET;
+        return false;
+    }
+
+    m_uringLimiter = std::make_unique<RateLimiter>(m_config.rateLimits);
+    m_uringHandler = [this](const char* data, int size, const sockaddr_in& sender)
+    {
+        ++m_uringReaped;
+
+        if (!AllowPacket(*m_uringLimiter, data, size, sender))
+            return;
+
+        ReceivedPacket& rx = m_uringReceived.emplace_back();
+        rx.packet = GamePacket(data, size);
+        rx.sender = sender;
+    };
+
+    m_uring = std::make_unique<IoUringBackend>();
+    if (!m_uring->Open(m_socket))
+    {
+        m_uring.reset();
+        Net::CloseSocket(m_socket);
+        m_socket = INVALID_SOCKET;
+        return false;
+    }
+
+    m_uringReceived.reserve(static_cast<size_t>(m_config.receiveBatchSize) * 4);
+    m_uringDispatch.reserve(static_cast<size_t>(m_config.receiveBatchSize) * 4);
+    return true;
+}
+
+bool NetworkServer::OpenShard(ReceiveShard& shard, bool reusePort)
+{
+    shard.socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (shard.socket == INVALID_SOCKET)
+    {
+        std::cerr << "Socket creation failed: " << Net::LastError() << "\n";
+        return false;
+    }
+
+#ifdef SO_REUSEPORT
+    if (reusePort)
+    {
+        int enable = 1;
+        if (setsockopt(shard.socket, SOL_SOCKET, SO_REUSEPORT, reinterpret_cast<const char*>(&enable), sizeof(enable)) == SOCKET_ERROR)
+        {
+            std::cerr << "SO_REUSEPORT failed: " << Net::LastError() << "\n";
+            return false;
+        }
+    }
+#endif
+
+    if (bind(shard.socket, reinterpret_cast<sockaddr*>(&m_serverAddr), sizeof(m_serverAddr)) == SOCKET_ERROR)
+    {
+        std::cerr << "Bind failed: " << Net::LastError() << "\n";
+        return false;
+    }
+
+    // Socket non bloquant surveille par la boucle d'evenements : le thread de reception
+    // ne reste plus bloque dans recvfrom et Stop() le reveille proprement.
+    if (!Net::SetNonBlocking(shard.socket) || !shard.eventLoop.Open() || !shard.eventLoop.Watch(shard.socket))
+    {
+        std::cerr << "Event loop setup failed: " << Net::LastError() << "\n";
+        return false;
+    }
+
+    shard.batch = std::make_unique<ReceiveBatch>(m_config.receiveBatchSize);
+    shard.limiter = std::make_unique<RateLimiter>(m_config.rateLimits);
     return true;
 }
 
 void NetworkServer::Stop()
 {
+    if (m_shards.empty() && !m_uring)
+        return;
+
+    FlushSends();
+
     m_isRunning = false;
-    if (m_socket != INVALID_SOCKET)
+
+    if (m_uring)
     {
-        closesocket(m_socket);
+        m_uring.reset();
+        Net::CloseSocket(m_socket);
         m_socket = INVALID_SOCKET;
+        m_uringReceived.clear();
     }
-    
-    if (m_receiveThread.joinable())
+
+    CloseShards();
+    m_gameWakeup.Close();
+    Net::Cleanup();
+}
+
+void NetworkServer::CloseShards()
+{
+    for (auto& shard : m_shards)
     {
-        m_receiveThread.join();
+        shard->eventLoop.Wakeup();
     }
-    
-    WSACleanup();
+
+    for (auto& shard : m_shards)
+    {
+        if (shard->thread.joinable())
+        {
+            shard->thread.join();
+        }
+
+        shard->eventLoop.Close();
+
+        if (shard->socket != INVALID_SOCKET)
+        {
+            Net::CloseSocket(shard->socket);
+            shard->socket = INVALID_SOCKET;
+        }
+    }
+
+    m_shards.clear();
+    m_socket = INVALID_SOCKET;
 }
 
 void NetworkServer::SendTo(const GamePacket& packet, const sockaddr_in& address)
@@ -73,77 +312,839 @@ void NetworkServer::SendTo(const GamePacket& packet, const sockaddr_in& address)
     if (m_socket == INVALID_SOCKET)
         return;
 
-    int sentBytes = sendto(m_socket, packet.Data(), packet.Size(), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    OutboundPacket& out = m_outbound.emplace_back();
+    out.owned = packet;
+    out.address = address;
+}
+
+void NetworkServer::SendTo(const IPacket& packet, const sockaddr_in& address, WireFormat format)
+{
+    if (packet.GetChannel() != ReliableChannel::None)
+    {
+        if (ReliablePeer* peer = FindReliable(address))
+        {
+            GamePacket payload;
+            packet.Serialize(payload, format);
+            SendReliable(*peer, packet.GetChannel(), payload);
+            return;
+        }
+    }
+
+    // Serialise directement dans l'entree de la file : tampon du pool, aucune copie
+    if (GamePacket* out = QueueSend(address))
+        packet.Serialize(*out, format);
+}
+
+GamePacket* NetworkServer::QueueSend(const sockaddr_in& address)
+{
+    if (m_socket == INVALID_SOCKET)
+        return nullptr;
+
+    OutboundPacket& out = m_outbound.emplace_back();
+    out.address = address;
+    return &out.owned;
+}
+
+void NetworkServer::SendTo(const EncodedPacket& packet, const sockaddr_in& address, ReliableChannel channel)
+{
+    if (m_socket == INVALID_SOCKET || !packet)
+        return;
+
+    if (channel != ReliableChannel::None)
+    {
+        if (ReliablePeer* peer = FindReliable(address))
+        {
+            SendReliable(*peer, channel, *packet);
+            return;
+        }
+    }
+
+    OutboundPacket& out = m_outbound.emplace_back();
+    out.shared = packet;
+    out.address = address;
+}
+
+void NetworkServer::FlushSends()
+{
+    // Nouveaux messages fiables, retransmissions echues et acks rejoignent le lot de ce tick
+    ServiceReliable();
+
+    if (m_outbound.empty())
+        return;
+
+    FragmentSends();
+    CoalesceSends();
+
+    if (m_socket == INVALID_SOCKET)
+    {
+        m_outbound.clear();
+        return;
+    }
+
+    const size_t total = m_outbound.size();
+    const size_t batchSize = static_cast<size_t>(m_config.sendBatchSize);
+
+    if (m_uring)
+    {
+        // Un io_uring_enter par lot de SENDMSG ; les tampons vivent jusqu'a la fin de SubmitSends
+        size_t index = 0;
+        while (index < total)
+        {
+            size_t queued = 0;
+            while (index < total)
+            {
+                const GamePacket& bytes = m_outbound[index].Bytes();
+                if (!m_uring->QueueSend(bytes.Data(), bytes.Size(), m_outbound[index].address))
+                    break;
+
+                ++index;
+                ++queued;
+            }
+
+            if (queued == 0)
+            {
+                m_sendErrors += total - index;
+                break;
+            }
+
+            int errors = m_uring->SubmitSends(m_uringHandler, m_config.sendWaitMs);
+            ++m_sendBatches;
+            m_sentDatagrams += queued - static_cast<size_t>(errors);
+            m_sendErrors += static_cast<uint64_t>(errors);
+        }
+
+        m_outbound.clear();
+        return;
+    }
+
+#ifdef __linux__
+    SendBatch& batch = *m_sendBatch;
+
+    bool stalled = false;
+    for (size_t start = 0; start < total && !stalled; start += batchSize)
+    {
+        unsigned int count = static_cast<unsigned int>(std::min(batchSize, total - start));
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            OutboundPacket& out = m_outbound[start + i];
+            const GamePacket& bytes = out.Bytes();
+
+            batch.iovecs[i].iov_base = const_cast<char*>(bytes.Data());
+            batch.iovecs[i].iov_len = static_cast<size_t>(bytes.Size());
+
+            batch.headers[i] = {};
+            batch.headers[i].msg_hdr.msg_name = &out.address;
+            batch.headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            batch.headers[i].msg_hdr.msg_iov = &batch.iovecs[i];
+            batch.headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // sendmmsg peut s'arreter en cours de lot : on reprend apres le dernier envoye
+        unsigned int sent = 0;
+        while (sent < count)
+        {
+            int result = sendmmsg(m_socket, &batch.headers[sent], count - sent, 0);
+            if (result <= 0)
+            {
+                int error = Net::LastError();
+
+                // Tampon d'envoi plein : on attend qu'il se vide, puis on reprend au meme datagramme
+                if (Net::IsWouldBlock(error))
+                {
+                    if (Net::WaitWritable(m_socket, m_config.sendWaitMs))
+                        continue;
+
+                    const size_t dropped = total - start - sent;
+                    std::cerr << "Sendmmsg: tampon d'envoi plein depuis " << m_config.sendWaitMs << " ms, " << dropped << " datagrammes abandonnes\n";
+                    m_sendErrors += dropped;
+                    stalled = true;
+                    break;
+                }
 
-    if (sentBytes == SOCKET_ERROR)
+                // Datagramme fautif abandonne, on continue avec le reste du lot
+                std::cerr << "Sendmmsg failed: " << error << "\n";
+                ++m_sendErrors;
+                ++sent;
+                continue;
+            }
+
+            ++m_sendBatches;
+            m_sentDatagrams += static_cast<uint64_t>(result);
+            sent += static_cast<unsigned int>(result);
+        }
+    }
+#else
+    for (size_t i = 0; i < total; ++i)
     {
-        std::cerr << "SendTo failed: " << WSAGetLastError() << "\n";
+        const OutboundPacket& out = m_outbound[i];
+        const GamePacket& bytes = out.Bytes();
+
+        int sentBytes = sendto(m_socket, bytes.Data(), bytes.Size(), 0, reinterpret_cast<const sockaddr*>(&out.address), sizeof(out.address));
+        if (sentBytes == SOCKET_ERROR)
+        {
+            int error = Net::LastError();
+
+            // Tampon d'envoi plein : attente bornee puis meme datagramme, sinon le reste du tick part a la trappe
+            if (Net::IsWouldBlock(error))
+            {
+                if (Net::WaitWritable(m_socket, m_config.sendWaitMs))
+                {
+                    --i;
+                    continue;
+                }
+
+                std::cerr << "SendTo: tampon d'envoi plein depuis " << m_config.sendWaitMs << " ms, " << (total - i) << " datagrammes abandonnes\n";
+                m_sendErrors += total - i;
+                break;
+            }
+
+            std::cerr << "SendTo failed: " << error << "\n";
+            ++m_sendErrors;
+        }
+        else
+        {
+            ++m_sentDatagrams;
+        }
     }
+
+    m_sendBatches += (total + batchSize - 1) / batchSize;
+#endif
+
+    // Rend les tampons au pool, garde la capacite du vecteur pour le prochain tick
+    m_outbound.clear();
 }
 
-void NetworkServer::SendTo(const IPacket& packet, const sockaddr_in& address)
+void NetworkServer::ReceiveLoop(ReceiveShard& shard)
 {
-    GamePacket rawPacket;
-    packet.Serialize(rawPacket);
-    SendTo(rawPacket, address);
+    EventLoop::Event events[8];
+
+    while (m_isRunning)
+    {
+        int count = shard.eventLoop.Wait(events, 8, -1);
+        if (count > 0)
+        {
+            // Un seul socket par shard
+            DrainSocket(shard);
+        }
+    }
 }
 
-void NetworkServer::ReceiveLoop()
+bool NetworkServer::AllowPacket(RateLimiter& limiter, const char* data, int size, const sockaddr_in& sender)
 {
-    char buffer[MAX_PACKET_SIZE];
-    
-    sockaddr_in sender;
-    int senderLen = sizeof(sender);
+    // Groupe : chaque paquet porte passe par son seau, un seul refus ecarte tout le datagramme.
+    // Groupe vide ou illisible : seau commun, comme un paquet illisible.
+    if (Bundle::IsBundle(data, static_cast<size_t>(size)))
+    {
+        bool allowed = true;
+        int entries = 0;
+        const bool wellFormed = Bundle::Unpack(data, static_cast<size_t>(size), [&](const char* entry, size_t entrySize)
+        {
+            allowed = AllowSingle(limiter, entry, static_cast<int>(entrySize), sender) && allowed;
+            ++entries;
+        });
+
+        if (wellFormed && entries > 0)
+            return allowed;
+    }
 
+    return AllowSingle(limiter, data, size, sender);
+}
+
+bool NetworkServer::AllowSingle(RateLimiter& limiter, const char* data, int size, const sockaddr_in& sender)
+{
+    // Trame fiable : le seau est celui du paquet qu'elle porte (ack seul : seau commun)
+    if (size > 0 && static_cast<uint8_t>(data[0]) == RELIABLE_FRAME)
+    {
+        data += Reliable::HeaderSize;
+        size = std::max(0, size - static_cast<int>(Reliable::HeaderSize));
+    }
+
+    // OpCode lu directement dans le tampon brut (en-tete historique ou compact) ; -1 si illisible
+    PacketHeader header;
+    const int opcode = PacketHeader::Parse(data, static_cast<size_t>(size), header) == PacketHeader::Status::Ok ? header.opcode : -1;
+
+    if (limiter.Allow(sender, opcode))
+        return true;
+
+    m_rateLimited[RateLimitConfig::BucketOf(opcode)].fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void NetworkServer::DrainSocket(ReceiveShard& shard)
+{
+    ReceiveBatch& batch = *shard.batch;
+
+    // Lit jusqu'a vider le socket : un seul reveil peut couvrir plusieurs lots
     while (m_isRunning)
     {
-        int bytes = recvfrom(m_socket, buffer, MAX_PACKET_SIZE, 0, reinterpret_cast<sockaddr*>(&sender), &senderLen);
-        if (bytes > 0)
+        int count = ReceiveBatchFrom(shard);
+        if (count <= 0)
+            break;
+
+        RecordBatch(count, batch.Size());
+
+        uint64_t drops = 0;
+        for (int i = 0; i < count; ++i)
         {
+            if (batch.lengths[i] <= 0)
+                continue;
+
+            // Refuse avant la copie : un client trop bavard ne coute qu'une recherche dans la table
+            if (!AllowPacket(*shard.limiter, batch.Buffer(i), batch.lengths[i], batch.senders[i]))
+                continue;
+
             ReceivedPacket rx;
-            rx.packet = GamePacket(buffer, bytes);
-            rx.sender = sender;
+            rx.packet = GamePacket(batch.Buffer(i), batch.lengths[i]);
+            rx.sender = batch.senders[i];
 
-            std::lock_guard<std::mutex> lock(m_mutex);
-            m_packetQueue.push(rx);
+            // Pas d'attente si le thread de jeu est en retard : on abandonne et on compte
+            if (!shard.packetQueue.TryPush(std::move(rx)))
+                ++drops;
         }
-        else
+
+        if (drops > 0)
+            m_queueDrops.fetch_add(drops, std::memory_order_relaxed);
+
+        NotifyGameThread();
+
+        if (count < batch.Size())
+            break;
+    }
+}
+
+int NetworkServer::ReceiveBatchFrom(ReceiveShard& shard)
+{
+    ReceiveBatch& batch = *shard.batch;
+
+#ifdef __linux__
+    if (batch.Size() > 1)
+    {
+        for (auto& header : batch.headers)
+        {
+            header.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            header.msg_hdr.msg_flags = 0;
+        }
+
+        int count = recvmmsg(shard.socket, batch.headers.data(), static_cast<unsigned int>(batch.Size()), MSG_DONTWAIT, nullptr);
+        if (count < 0)
+        {
+            int error = Net::LastError();
+            if (!Net::IsWouldBlock(error) && m_isRunning)
+            {
+                std::cerr << "Recvmmsg error: " << error << "\n";
+            }
+            return 0;
+        }
+
+        for (int i = 0; i < count; ++i)
         {
-            if (m_isRunning)
+            batch.lengths[i] = static_cast<int>(batch.headers[i].msg_len);
+
+            // Un datagramme tronque est illisible : abandonne (DrainSocket ignore les longueurs nulles)
+            if (batch.headers[i].msg_hdr.msg_flags & MSG_TRUNC)
             {
-                std::cerr << "Recvfrom error: " << WSAGetLastError() << "\n";
+                batch.lengths[i] = 0;
+                m_truncatedDatagrams.fetch_add(1, std::memory_order_relaxed);
             }
         }
+
+        return count;
+    }
+#endif
+
+    // Fallback : recvfrom en boucle, mais toujours publie en un seul lot.
+    // MSG_TRUNC rend la taille reelle (Linux) ; Winsock signale l'exces en WSAEMSGSIZE.
+#if defined(MSG_TRUNC) && !defined(_WIN32)
+    constexpr int ReceiveFlags = MSG_TRUNC;
+#else
+    constexpr int ReceiveFlags = 0;
+#endif
+
+    int count = 0;
+    while (count < batch.Size())
+    {
+        SocketLen senderLen = sizeof(sockaddr_in);
+        int bytes = recvfrom(shard.socket, batch.Buffer(count), MAX_PACKET_SIZE, ReceiveFlags, reinterpret_cast<sockaddr*>(&batch.senders[count]), &senderLen);
+        if (bytes > MAX_PACKET_SIZE || (bytes < 0 && Net::IsMessageTooLong(Net::LastError())))
+        {
+            // Tronque : abandonne comme dans le chemin recvmmsg (longueur nulle ignoree)
+            batch.lengths[count++] = 0;
+            m_truncatedDatagrams.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (bytes < 0)
+        {
+            int error = Net::LastError();
+            if (!Net::IsWouldBlock(error) && m_isRunning)
+            {
+                std::cerr << "Recvfrom error: " << error << "\n";
+            }
+            break;
+        }
+
+        batch.lengths[count++] = bytes;
+    }
+
+    return count;
+}
+
+void NetworkServer::RecordBatch(int count, int batchSize)
+{
+    m_receiveBatches.fetch_add(1, std::memory_order_relaxed);
+    m_receivedDatagrams.fetch_add(static_cast<uint64_t>(count), std::memory_order_relaxed);
+
+    if (count >= batchSize)
+        m_fullBatches.fetch_add(1, std::memory_order_relaxed);
+
+    int bucket = std::min(static_cast<int>(std::bit_width(static_cast<unsigned int>(count))) - 1, NetworkStats::BatchHistogramSize - 1);
+    m_batchFill[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void NetworkServer::NotifyGameThread()
+{
+    // Paire avec le store de WaitForPackets : soit le thread de jeu voit le paquet
+    // avant de dormir, soit on voit qu'il dort et on le reveille.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_gameWaiting.exchange(false, std::memory_order_acq_rel))
+        m_gameWakeup.Wakeup();
+}
+
+void NetworkServer::Wakeup()
+{
+    // Meme protocole que NotifyGameThread, avec un drapeau en plus : les files des autres
+    // threads ne sont pas visibles d'ici, WaitForPackets ne peut pas les consulter avant de dormir
+    m_wakeRequested.store(true, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (m_gameWaiting.exchange(false, std::memory_order_acq_rel))
+    {
+        if (m_uring)
+            m_uring->Wakeup();
+        else
+            m_gameWakeup.Wakeup();
+    }
+}
+
+bool NetworkServer::HasPendingPackets() const
+{
+    for (const auto& shard : m_shards)
+    {
+        if (shard->packetQueue.Size() > 0)
+            return true;
+    }
+
+    return false;
+}
+
+void NetworkServer::WaitForPackets(std::chrono::steady_clock::time_point deadline)
+{
+    constexpr int MaxIdleWaitMs = 1000;
+
+    auto now = std::chrono::steady_clock::now();
+    if (deadline <= now)
+        return;
+
+    auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+    int timeoutMs = static_cast<int>(std::min<int64_t>((remaining.count() + 999) / 1000, MaxIdleWaitMs));
+
+    m_gameWaiting.store(true, std::memory_order_seq_cst);
+    if (m_wakeRequested.exchange(false, std::memory_order_acq_rel))
+    {
+        m_gameWaiting.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    if (m_uring)
+    {
+        // Meme file de completion pour les receptions, les reveils et le timeout
+        if (m_uringReceived.empty())
+            m_uring->Wait(timeoutMs);
+    }
+    else if (!HasPendingPackets())
+    {
+        EventLoop::Event unused[1];
+        m_gameWakeup.Wait(unused, 1, timeoutMs);
     }
+
+    m_gameWaiting.store(false, std::memory_order_relaxed);
+
+    // Le reveil a ete servi : ce qui a ete produit avant est traite au tick qui suit
+    m_wakeRequested.exchange(false, std::memory_order_acq_rel);
+}
+
+NetworkStats NetworkServer::GetStats() const
+{
+    NetworkStats stats;
+    stats.receiveBatches = m_receiveBatches.load(std::memory_order_relaxed);
+    stats.receivedDatagrams = m_receivedDatagrams.load(std::memory_order_relaxed);
+    stats.fullBatches = m_fullBatches.load(std::memory_order_relaxed);
+    stats.queueDrops = m_queueDrops.load(std::memory_order_relaxed);
+    stats.truncatedDatagrams = m_truncatedDatagrams.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < RateLimitConfig::BucketCount; ++i)
+    {
+        stats.rateLimitedByOpCode[i] = m_rateLimited[i].load(std::memory_order_relaxed);
+        stats.rateLimited += stats.rateLimitedByOpCode[i];
+    }
+
+    stats.unknownPackets = m_dispatcher.GetUnknownPackets();
+    stats.malformedPackets = m_dispatcher.GetMalformedPackets();
+
+    stats.sendBatches = m_sendBatches;
+    stats.sentDatagrams = m_sentDatagrams;
+    stats.sendErrors = m_sendErrors;
+
+    stats.reliablePeers = m_reliablePeers.size();
+    stats.reliable = m_closedReliableStats;
+    for (const auto& entry : m_reliablePeers)
+    {
+        stats.reliable += entry.second->endpoint.GetStats();
+    }
+    stats.rejectedFrames = m_rejectedFrames;
+
+    stats.bundles = m_bundles;
+    stats.bundledPackets = m_bundledPackets;
+
+    stats.fragmentedPackets = m_fragmentedPackets;
+    stats.fragments = m_fragments;
+    stats.oversizedPackets = m_oversizedPackets;
+
+    for (int i = 0; i < NetworkStats::BatchHistogramSize; ++i)
+    {
+        stats.batchFill[i] = m_batchFill[i].load(std::memory_order_relaxed);
+    }
+
+    return stats;
 }
 
 void NetworkServer::PollEvents()
 {
-    std::queue<ReceivedPacket> tempQueue;
+    if (m_uring)
+    {
+        m_uring->ProcessCompletions(m_uringHandler);
+        m_truncatedDatagrams.fetch_add(m_uring->TakeTruncatedDatagrams(), std::memory_order_relaxed);
+        if (m_uringReaped > 0)
+            RecordBatch(m_uringReaped, m_config.receiveBatchSize);
+        m_uringReaped = 0;
+
+        // Les handlers peuvent envoyer (et donc reaper d'autres receptions) : on distribue une copie
+        std::swap(m_uringReceived, m_uringDispatch);
+        for (auto& p : m_uringDispatch)
+        {
+            DispatchPacket(p);
+        }
+        m_uringDispatch.clear();
+        return;
+    }
+
+    // Fusionne les files des shards. L'ordre entre shards est libre, mais un expediteur
+    // n'alimente qu'un seul shard : ses paquets restent dans l'ordre.
+    ReceivedPacket p;
+
+    for (auto& shard : m_shards)
+    {
+        // Borne a une file pleine par appel : un shard inonde ne bloque pas la boucle de jeu
+        size_t budget = shard->packetQueue.Capacity();
+
+        while (budget-- > 0 && shard->packetQueue.TryPop(p))
+        {
+            DispatchPacket(p);
+        }
+    }
+}
+
+void NetworkServer::DispatchPacket(ReceivedPacket& p)
+{
+    if (Bundle::IsBundle(p.packet.Data(), static_cast<size_t>(p.packet.Size())))
+    {
+        // Chaque entree est distribuee comme un datagramme recu seul, dans l'ordre
+        ReceivedPacket entry;
+        entry.sender = p.sender;
+
+        const bool wellFormed = Bundle::Unpack(p.packet.Data(), static_cast<size_t>(p.packet.Size()), [this, &entry](const char* data, size_t size)
+        {
+            entry.packet = GamePacket(data, static_cast<int>(size));
+            DispatchPacket(entry);
+        });
+
+        if (!wellFormed)
+            ++m_rejectedFrames;
+        return;
+    }
+
+    if (p.packet.Size() > 0 && static_cast<uint8_t>(p.packet.Data()[0]) == RELIABLE_FRAME)
+    {
+        ReceiveReliable(p);
+        return;
+    }
+
+    m_dispatcher.Dispatch(p.packet, p.sender);
+}
+
+uint64_t NetworkServer::PeerKey(const sockaddr_in& address)
+{
+    return (static_cast<uint64_t>(address.sin_addr.s_addr) << 16) | address.sin_port;
+}
+
+NetworkServer::ReliablePeer* NetworkServer::FindReliable(const sockaddr_in& address)
+{
+    if (m_reliablePeers.empty())
+        return nullptr;
+
+    auto it = m_reliablePeers.find(PeerKey(address));
+    return it != m_reliablePeers.end() ? it->second.get() : nullptr;
+}
+
+bool NetworkServer::IsReliable(const sockaddr_in& address) const
+{
+    return m_reliablePeers.count(PeerKey(address)) > 0;
+}
+
+void NetworkServer::OpenReliable(const sockaddr_in& address)
+{
+    // Le client repart lui aussi de zero a chaque login
+    CloseReliable(address);
+
+    auto peer = std::make_unique<ReliablePeer>();
+    peer->address = address;
+    peer->endpoint.Announce();
+    m_activeReliable.insert(peer.get());
+    m_reliablePeers[PeerKey(address)] = std::move(peer);
+}
+
+void NetworkServer::CloseReliable(const sockaddr_in& address)
+{
+    auto it = m_reliablePeers.find(PeerKey(address));
+    if (it == m_reliablePeers.end())
+        return;
+
+    m_closedReliableStats += it->second->endpoint.GetStats();
+    m_activeReliable.erase(it->second.get());
+    m_reliablePeers.erase(it);
+}
+
+void NetworkServer::SetBundling(const sockaddr_in& address, bool enabled)
+{
+    if (enabled)
+        m_bundlePeers.insert(PeerKey(address));
+    else
+        m_bundlePeers.erase(PeerKey(address));
+}
+
+bool NetworkServer::IsBundling(const sockaddr_in& address) const
+{
+    return m_bundlePeers.count(PeerKey(address)) > 0;
+}
+
+void NetworkServer::SetFragmentation(const sockaddr_in& address, bool enabled)
+{
+    if (enabled)
+        m_fragmentPeers.try_emplace(PeerKey(address), uint16_t{ 0 });
+    else
+        m_fragmentPeers.erase(PeerKey(address));
+}
+
+bool NetworkServer::IsFragmenting(const sockaddr_in& address) const
+{
+    return m_fragmentPeers.count(PeerKey(address)) > 0;
+}
+
+void NetworkServer::FragmentSends()
+{
+    if (m_fragmentPeers.empty())
+        return;
+
+    // Cas courant : aucun paquet trop gros, la file reste telle quelle
+    auto oversized = std::find_if(m_outbound.begin(), m_outbound.end(), [](const OutboundPacket& out)
+    {
+        return Fragment::NeedsSplit(static_cast<size_t>(out.Bytes().Size()));
+    });
+
+    if (oversized == m_outbound.end())
+        return;
+
+    // Reconstruit la file dans l'ordre : les fragments prennent la place de leur paquet
+    m_fragmented.clear();
+    m_fragmented.reserve(m_outbound.size() + Fragment::MaxFragments);
+
+    for (OutboundPacket& out : m_outbound)
+    {
+        const GamePacket& bytes = out.Bytes();
+        auto peer = m_fragmentPeers.find(PeerKey(out.address));
+
+        if (peer == m_fragmentPeers.end() || !Fragment::NeedsSplit(static_cast<size_t>(bytes.Size())))
+        {
+            m_fragmented.push_back(std::move(out));
+            continue;
+        }
+
+        const size_t before = m_fragmented.size();
+        const bool split = Fragment::Split(bytes.Data(), static_cast<size_t>(bytes.Size()), peer->second++, [this, &out]
+        {
+            OutboundPacket& fragment = m_fragmented.emplace_back();
+            fragment.address = out.address;
+            return &fragment.owned;
+        });
+
+        if (!split)
+        {
+            // Au-dela de Fragment::MaxMessageSize : le pair ne pourrait pas le reassembler
+            m_fragmented.resize(before);
+            ++m_oversizedPackets;
+            continue;
+        }
+
+        ++m_fragmentedPackets;
+        m_fragments += m_fragmented.size() - before;
+    }
+
+    m_outbound.swap(m_fragmented);
+    m_fragmented.clear();
+}
+
+void NetworkServer::CoalesceSends()
+{
+    if (!m_config.coalesceSends || m_bundlePeers.empty() || m_outbound.size() < 2)
+        return;
+
+    // Un paquet rejoint le datagramme ouvert de son pair s'il y tient ; sinon il prend sa place dans
+    // la file et devient le nouveau datagramme ouvert. write <= read : compaction sur place.
+    m_openBundles.clear();
+
+    size_t write = 0;
+    for (size_t read = 0; read < m_outbound.size(); ++read)
     {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        std::swap(tempQueue, m_packetQueue);
+        OutboundPacket& out = m_outbound[read];
+        const uint64_t key = PeerKey(out.address);
+        const bool bundling = m_bundlePeers.count(key) > 0;
+
+        if (bundling)
+        {
+            auto open = m_openBundles.find(key);
+            if (open != m_openBundles.end() && AppendToBundle(m_outbound[open->second], out.Bytes()))
+                continue;
+        }
+
+        if (write != read)
+            m_outbound[write] = std::move(out);
+
+        // Un paquet trop gros part seul ; les suivants ouvrent un nouveau groupe apres lui
+        if (bundling && Bundle::Fits(static_cast<size_t>(m_outbound[write].Bytes().Size())))
+            m_openBundles[key] = write;
+        else if (bundling)
+            m_openBundles.erase(key);
+
+        ++write;
     }
 
-    while (!tempQueue.empty())
+    m_outbound.resize(write);
+}
+
+bool NetworkServer::AppendToBundle(OutboundPacket& head, const GamePacket& bytes)
+{
+    const GamePacket& current = head.Bytes();
+
+    if (Bundle::IsBundle(current.Data(), static_cast<size_t>(current.Size())))
     {
-        ReceivedPacket& p = tempQueue.front();
+        // Le groupe est forcement dans le tampon propre de l'entree
+        if (!Bundle::Append(head.owned, bytes.Data(), static_cast<size_t>(bytes.Size())))
+            return false;
+
+        ++m_bundledPackets;
+        return true;
+    }
 
-        int typeInt = 0;
-        p.packet >> typeInt;
-        OpCode type = static_cast<OpCode>(typeInt);
+    GamePacket bundle;
+    if (!Bundle::Begin(bundle, current, bytes))
+        return false;
+
+    head.owned = std::move(bundle);
+    head.shared.reset();
 
-        auto it = m_handlers.find(type);
-        if (it != m_handlers.end())
+    ++m_bundles;
+    m_bundledPackets += 2;
+    return true;
+}
+
+void NetworkServer::SendReliable(ReliablePeer& peer, ReliableChannel channel, const GamePacket& payload)
+{
+    peer.endpoint.Send(static_cast<int>(channel), payload.Data(), static_cast<size_t>(payload.Size()));
+    peer.touched = true;
+    m_activeReliable.insert(&peer);
+}
+
+void NetworkServer::ReceiveReliable(ReceivedPacket& p)
+{
+    ReliablePeer* peer = FindReliable(p.sender);
+    const bool accepted = peer && peer->endpoint.Receive(p.packet.Data(), static_cast<size_t>(p.packet.Size()), std::chrono::steady_clock::now(), [this](GamePacket& packet)
+    {
+        m_reliableDelivered.push_back(std::move(packet));
+    });
+
+    if (!accepted)
+    {
+        ++m_rejectedFrames;
+        return;
+    }
+
+    // Ack a renvoyer, et peut-etre de la place dans la fenetre
+    peer->touched = true;
+    m_activeReliable.insert(peer);
+
+    // Distribues une fois Receive termine, depuis une copie : un handler peut fermer cette extremite
+    std::vector<GamePacket> delivered;
+    delivered.swap(m_reliableDelivered);
+
+    for (GamePacket& packet : delivered)
+    {
+        m_dispatcher.Dispatch(packet, p.sender);
+    }
+
+    delivered.clear();
+    if (m_reliableDelivered.empty())
+        m_reliableDelivered.swap(delivered);
+}
+
+void NetworkServer::ServiceReliable()
+{
+    if (m_activeReliable.empty() || m_socket == INVALID_SOCKET)
+        return;
+
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = m_activeReliable.begin(); it != m_activeReliable.end();)
+    {
+        ReliablePeer& peer = **it;
+        if (!peer.touched && now < peer.endpoint.NextDeadline())
         {
-            it->second(p.packet, p.sender);
+            ++it;
+            continue;
         }
-        
-        tempQueue.pop();
+
+        peer.touched = false;
+        peer.endpoint.Service(now, [this, &peer] { return QueueSend(peer.address); });
+
+        if (peer.endpoint.IsIdle())
+            it = m_activeReliable.erase(it);
+        else
+            ++it;
+    }
+}
+
+std::chrono::steady_clock::time_point NetworkServer::NextReliableDeadline() const
+{
+    // Un pair inactif n'a rien en vol ; chaque extremite garde son echeance a jour
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    for (const ReliablePeer* peer : m_activeReliable)
+    {
+        deadline = std::min(deadline, peer->endpoint.NextDeadline());
     }
+    return deadline;
 }
 
 void NetworkServer::OnPacket(OpCode type, PacketHandler handler)
 {
-    m_handlers[type] = handler;
+    m_dispatcher.On(type, std::move(handler));
 }
@@ -0,0 +1,262 @@
+#include "Platform/EventLoop.h"
+
+#include <iostream>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+
+#ifdef __linux__
+
+// ==== Linux : epoll + eventfd ====
+
+EventLoop::EventLoop() : m_epollFd(-1), m_wakeupFd(-1)
+{
+}
+
+EventLoop::~EventLoop()
+{
+    Close();
+}
+
+bool EventLoop::Open()
+{
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0)
+    {
+        std::cerr << "epoll_create1 failed: " << errno << "\n";
+        return false;
+    }
+
+    m_wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeupFd < 0)
+    {
+        std::cerr << "eventfd failed: " << errno << "\n";
+        Close();
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeupFd, &ev) != 0)
+    {
+        std::cerr << "epoll_ctl(wakeup) failed: " << errno << "\n";
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void EventLoop::Close()
+{
+    if (m_wakeupFd >= 0)
+    {
+        close(m_wakeupFd);
+        m_wakeupFd = -1;
+    }
+
+    if (m_epollFd >= 0)
+    {
+        close(m_epollFd);
+        m_epollFd = -1;
+    }
+
+    m_registered.clear();
+}
+
+bool EventLoop::Watch(SOCKET socket, void* userData)
+{
+    auto entry = std::make_unique<Event>(Event{ socket, userData });
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = entry.get();
+
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, socket, &ev) != 0)
+    {
+        std::cerr << "epoll_ctl(add) failed: " << errno << "\n";
+        return false;
+    }
+
+    m_registered.push_back(std::move(entry));
+    return true;
+}
+
+void EventLoop::Unwatch(SOCKET socket)
+{
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, socket, nullptr);
+
+    m_registered.erase(std::remove_if(m_registered.begin(), m_registered.end(), [socket](const std::unique_ptr<Event>& e) { return e->socket == socket; }), m_registered.end());
+}
+
+int EventLoop::Wait(Event* events, int maxEvents, int timeoutMs)
+{
+    epoll_event ready[64];
+    int count = epoll_wait(m_epollFd, ready, std::min(maxEvents + 1, 64), timeoutMs);
+    if (count < 0)
+    {
+        if (errno != EINTR)
+            std::cerr << "epoll_wait failed: " << errno << "\n";
+
+        return 0;
+    }
+
+    int written = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        if (ready[i].data.ptr == nullptr)
+        {
+            DrainWakeup();
+            continue;
+        }
+
+        if (written < maxEvents)
+            events[written++] = *static_cast<Event*>(ready[i].data.ptr);
+    }
+
+    return written;
+}
+
+void EventLoop::Wakeup()
+{
+    uint64_t one = 1;
+    ssize_t ignored = write(m_wakeupFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void EventLoop::DrainWakeup()
+{
+    uint64_t value = 0;
+    ssize_t ignored = read(m_wakeupFd, &value, sizeof(value));
+    (void)ignored;
+}
+
+#else
+
+// ==== Fallback : poll / WSAPoll + socket UDP loopback pour le reveil ====
+
+#ifdef _WIN32
+using PollFd = WSAPOLLFD;
+static int PollSockets(PollFd* fds, size_t count, int timeoutMs) { return WSAPoll(fds, static_cast<ULONG>(count), timeoutMs); }
+#else
+using PollFd = pollfd;
+static int PollSockets(PollFd* fds, size_t count, int timeoutMs) { return poll(fds, static_cast<nfds_t>(count), timeoutMs); }
+#endif
+
+EventLoop::EventLoop() : m_wakeupSocket(INVALID_SOCKET), m_wakeupAddr{}
+{
+}
+
+EventLoop::~EventLoop()
+{
+    Close();
+}
+
+bool EventLoop::Open()
+{
+    m_wakeupSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_wakeupSocket == INVALID_SOCKET)
+    {
+        std::cerr << "Wakeup socket creation failed: " << Net::LastError() << "\n";
+        return false;
+    }
+
+    m_wakeupAddr.sin_family = AF_INET;
+    m_wakeupAddr.sin_port = 0;
+    m_wakeupAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    SocketLen addrLen = sizeof(m_wakeupAddr);
+    if (bind(m_wakeupSocket, reinterpret_cast<sockaddr*>(&m_wakeupAddr), sizeof(m_wakeupAddr)) == SOCKET_ERROR
+        || getsockname(m_wakeupSocket, reinterpret_cast<sockaddr*>(&m_wakeupAddr), &addrLen) == SOCKET_ERROR)
+    {
+        std::cerr << "Wakeup socket bind failed: " << Net::LastError() << "\n";
+        Close();
+        return false;
+    }
+
+    Net::SetNonBlocking(m_wakeupSocket);
+    return true;
+}
+
+void EventLoop::Close()
+{
+    if (m_wakeupSocket != INVALID_SOCKET)
+    {
+        Net::CloseSocket(m_wakeupSocket);
+        m_wakeupSocket = INVALID_SOCKET;
+    }
+
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    m_watched.clear();
+}
+
+bool EventLoop::Watch(SOCKET socket, void* userData)
+{
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    m_watched.push_back({ socket, userData });
+    return true;
+}
+
+void EventLoop::Unwatch(SOCKET socket)
+{
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    m_watched.erase(std::remove_if(m_watched.begin(), m_watched.end(), [socket](const Event& e) { return e.socket == socket; }), m_watched.end());
+}
+
+int EventLoop::Wait(Event* events, int maxEvents, int timeoutMs)
+{
+    std::vector<Event> watched;
+    {
+        std::lock_guard<std::mutex> lock(m_watchMutex);
+        watched = m_watched;
+    }
+
+    std::vector<PollFd> fds(watched.size() + 1);
+    fds[0].fd = m_wakeupSocket;
+    fds[0].events = POLLIN;
+
+    for (size_t i = 0; i < watched.size(); ++i)
+    {
+        fds[i + 1].fd = watched[i].socket;
+        fds[i + 1].events = POLLIN;
+    }
+
+    int count = PollSockets(fds.data(), fds.size(), timeoutMs);
+    if (count <= 0)
+        return 0;
+
+    if (fds[0].revents & POLLIN)
+        DrainWakeup();
+
+    int written = 0;
+    for (size_t i = 1; i < fds.size() && written < maxEvents; ++i)
+    {
+        if (fds[i].revents & (POLLIN | POLLERR | POLLHUP))
+            events[written++] = watched[i - 1];
+    }
+
+    return written;
+}
+
+void EventLoop::Wakeup()
+{
+    char byte = 1;
+    sendto(m_wakeupSocket, &byte, 1, 0, reinterpret_cast<const sockaddr*>(&m_wakeupAddr), sizeof(m_wakeupAddr));
+}
+
+void EventLoop::DrainWakeup()
+{
+    char buffer[64];
+    while (recv(m_wakeupSocket, buffer, sizeof(buffer), 0) > 0)
+    {
+    }
+}
+
+#endif
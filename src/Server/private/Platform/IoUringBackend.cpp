@@ -0,0 +1,796 @@
+#include "Platform/IoUringBackend.h"
+#include "NetworkCommon.h"
+
+#include <iostream>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define NETLESSONS_HAS_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#endif
+
+
+#ifdef NETLESSONS_HAS_IO_URING
+
+namespace
+{
+    // user_data : index d'un emplacement de reception, SendTagBase + index d'un emplacement
+    // d'envoi (pour le resoumettre sur -EAGAIN), MultishotTag ou WakeupTag
+    constexpr uint64_t MultishotTag = ~uint64_t(0);
+    constexpr uint64_t WakeupTag = MultishotTag - 1;
+    constexpr uint64_t SendTagBase = uint64_t(1) << 32;
+    constexpr uint16_t BufferGroup = 0;
+
+    // En-tete ecrit par le noyau devant chaque datagramme recu en multishot
+    constexpr size_t MultishotHeaderSize = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in);
+    constexpr size_t MultishotBufferSize = MultishotHeaderSize + MAX_PACKET_SIZE;
+
+    int SysSetup(unsigned entries, io_uring_params* params)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int SysEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags, const void* arg, size_t argSize)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+    }
+
+    int SysRegister(int fd, unsigned opcode, void* arg, unsigned count)
+    {
+        return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+    }
+
+    template <typename T>
+    T LoadAcquire(const T* ptr)
+    {
+        return std::atomic_ref<T>(*const_cast<T*>(ptr)).load(std::memory_order_acquire);
+    }
+
+    template <typename T>
+    void StoreRelease(T* ptr, T value)
+    {
+        std::atomic_ref<T>(*ptr).store(value, std::memory_order_release);
+    }
+}
+
+
+struct IoUringBackend::Ring
+{
+    int fd = -1;
+    SOCKET socket = INVALID_SOCKET;
+
+    // Anneaux partages avec le noyau (SQ et CQ dans le meme mapping)
+    void* ringPtr = MAP_FAILED;
+    size_t ringSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned sqLocalTail = 0;
+    unsigned sqPending = 0;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned cqMask = 0;
+
+    // ---- Mode multishot : un seul RECVMSG, tampons pioches dans l'anneau fourni ----
+    bool multishot = false;
+    bool multishotArmed = false;
+    uint64_t multishotDelivered = 0;
+    msghdr multishotMsg = {};
+
+    io_uring_buf_ring* bufRing = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+    size_t bufRingSize = 0;
+    char* bufRingBuffers = static_cast<char*>(MAP_FAILED);
+    size_t bufRingBuffersSize = 0;
+    unsigned bufRingCount = 0;
+    uint16_t bufRingLocalTail = 0;
+    bool bufRingRegistered = false;
+
+    // ---- Mode de repli : receiveSlots RECVMSG simples, chacun sur son tampon ----
+    struct RecvSlot
+    {
+        msghdr msg = {};
+        iovec iov = {};
+        sockaddr_in address = {};
+    };
+
+    unsigned slotCount = 0;
+    std::vector<RecvSlot> recvSlots;
+    std::vector<char> recvBuffers;
+    std::vector<unsigned> recvToArm;
+    bool recvFatal = false;
+
+    // Emplacements d'envoi : msghdr/iovec/adresse doivent vivre jusqu'a la completion
+    struct SendSlot
+    {
+        msghdr msg = {};
+        iovec iov = {};
+        sockaddr_in address = {};
+    };
+
+    std::vector<SendSlot> sendSlots;
+    std::vector<unsigned> sendRetry;   // termines sur -EAGAIN (tampon d'envoi plein)
+    unsigned sendQueued = 0;
+    unsigned sendInFlight = 0;
+    int sendErrors = 0;
+
+    void PrepareSend(io_uring_sqe* sqe, unsigned index)
+    {
+        sqe->opcode = IORING_OP_SENDMSG;
+        sqe->fd = socket;
+        sqe->addr = reinterpret_cast<uint64_t>(&sendSlots[index].msg);
+        sqe->len = 1;
+        sqe->user_data = SendTagBase + index;
+        ++sendInFlight;
+    }
+
+    // Reveil depuis un autre thread : POLL_ADD sur un eventfd, reposte apres chaque completion
+    int wakeupFd = -1;
+    bool wakeupArmed = false;
+
+    ~Ring()
+    {
+        ReleaseBufferRing();
+
+        if (wakeupFd >= 0)
+            close(wakeupFd);
+
+        if (sqes != MAP_FAILED)
+            munmap(sqes, sqesSize);
+
+        if (ringPtr != MAP_FAILED)
+            munmap(ringPtr, ringSize);
+
+        if (fd >= 0)
+            close(fd);
+    }
+
+    io_uring_sqe* GetSqe()
+    {
+        unsigned head = LoadAcquire(sqHead);
+        if (sqLocalTail - head >= sqEntries)
+        {
+            // File de soumission pleine : on pousse ce qu'on a deja
+            Submit(0, 0);
+            head = LoadAcquire(sqHead);
+            if (sqLocalTail - head >= sqEntries)
+                return nullptr;
+        }
+
+        unsigned index = sqLocalTail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+
+        sqArray[index] = index;
+        ++sqLocalTail;
+        ++sqPending;
+        return sqe;
+    }
+
+    int Submit(unsigned minComplete, unsigned flags, const void* arg = nullptr, size_t argSize = 0)
+    {
+        StoreRelease(sqTail, sqLocalTail);
+
+        unsigned toSubmit = sqPending;
+        sqPending = 0;
+
+        if (toSubmit == 0 && minComplete == 0)
+            return 0;
+
+        int result = SysEnter(fd, toSubmit, minComplete, flags | (minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u), arg, argSize);
+        if (result < 0 && errno != ETIME && errno != EINTR && errno != EBUSY)
+            std::cerr << "io_uring_enter failed: " << errno << "\n";
+
+        return result;
+    }
+
+    // --- Anneau de tampons fournis (noyaux >= 5.19, multishot recvmsg >= 6.0) ---
+    bool SetupBufferRing(unsigned count)
+    {
+        bufRingCount = std::bit_ceil(std::max(count, 2u));
+        bufRingSize = bufRingCount * sizeof(io_uring_buf);
+        bufRing = static_cast<io_uring_buf_ring*>(mmap(nullptr, bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (bufRing == MAP_FAILED)
+            return false;
+
+        bufRingBuffersSize = bufRingCount * MultishotBufferSize;
+        bufRingBuffers = static_cast<char*>(mmap(nullptr, bufRingBuffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (bufRingBuffers == MAP_FAILED)
+            return false;
+
+        io_uring_buf_reg reg = {};
+        reg.ring_addr = reinterpret_cast<uint64_t>(bufRing);
+        reg.ring_entries = bufRingCount;
+        reg.bgid = BufferGroup;
+
+        if (SysRegister(fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+            return false;
+
+        bufRingRegistered = true;
+
+        for (unsigned i = 0; i < bufRingCount; ++i)
+        {
+            RecycleBuffer(i);
+        }
+        PublishBuffers();
+
+        // Le noyau recopie ce msghdr pour chaque datagramme : seule la taille de l'adresse compte
+        multishotMsg.msg_namelen = sizeof(sockaddr_in);
+        return true;
+    }
+
+    void ReleaseBufferRing()
+    {
+        if (bufRingRegistered)
+        {
+            io_uring_buf_reg reg = {};
+            reg.bgid = BufferGroup;
+            SysRegister(fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+            bufRingRegistered = false;
+        }
+
+        if (bufRingBuffers != MAP_FAILED)
+            munmap(bufRingBuffers, bufRingBuffersSize);
+
+        if (bufRing != MAP_FAILED)
+            munmap(bufRing, bufRingSize);
+
+        bufRingBuffers = static_cast<char*>(MAP_FAILED);
+        bufRing = static_cast<io_uring_buf_ring*>(MAP_FAILED);
+    }
+
+    char* RingBufferAt(unsigned bid)
+    {
+        return bufRingBuffers + static_cast<size_t>(bid) * MultishotBufferSize;
+    }
+
+    void RecycleBuffer(unsigned bid)
+    {
+        io_uring_buf* buf = &bufRing->bufs[bufRingLocalTail & (bufRingCount - 1)];
+        buf->addr = reinterpret_cast<uint64_t>(RingBufferAt(bid));
+        buf->len = static_cast<uint32_t>(MultishotBufferSize);
+        buf->bid = static_cast<uint16_t>(bid);
+        ++bufRingLocalTail;
+    }
+
+    void PublishBuffers()
+    {
+        StoreRelease(&bufRing->tail, bufRingLocalTail);
+    }
+
+    bool ArmMultishot()
+    {
+        io_uring_sqe* sqe = GetSqe();
+        if (sqe == nullptr)
+            return false;
+
+        sqe->opcode = IORING_OP_RECVMSG;
+        sqe->fd = socket;
+        sqe->addr = reinterpret_cast<uint64_t>(&multishotMsg);
+        sqe->len = 1;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;
+        sqe->buf_group = BufferGroup;
+        sqe->user_data = MultishotTag;
+
+        multishotArmed = true;
+        multishotDelivered = 0;
+        return true;
+    }
+
+    // --- Repli : RECVMSG simples ---
+    void EnableSlotReceives()
+    {
+        multishot = false;
+        ReleaseBufferRing();
+
+        recvSlots.resize(slotCount);
+        recvBuffers.resize(static_cast<size_t>(slotCount) * MAX_PACKET_SIZE);
+        recvToArm.reserve(slotCount);
+        for (unsigned i = slotCount; i-- > 0;)
+        {
+            recvToArm.push_back(i);
+        }
+    }
+
+    char* SlotBufferAt(unsigned slot)
+    {
+        return recvBuffers.data() + static_cast<size_t>(slot) * MAX_PACKET_SIZE;
+    }
+
+    // Reposte les receptions terminees ; celles qui ne trouvent pas de SQE attendent le prochain passage
+    void ArmReceives()
+    {
+        if (multishot)
+        {
+            if (!multishotArmed)
+                ArmMultishot();
+
+            return;
+        }
+
+        while (!recvToArm.empty())
+        {
+            io_uring_sqe* sqe = GetSqe();
+            if (sqe == nullptr)
+                break;
+
+            unsigned index = recvToArm.back();
+            recvToArm.pop_back();
+
+            RecvSlot& slot = recvSlots[index];
+            slot.iov.iov_base = SlotBufferAt(index);
+            slot.iov.iov_len = MAX_PACKET_SIZE;
+            slot.msg = {};
+            slot.msg.msg_name = &slot.address;
+            slot.msg.msg_namelen = sizeof(sockaddr_in);
+            slot.msg.msg_iov = &slot.iov;
+            slot.msg.msg_iovlen = 1;
+
+            sqe->opcode = IORING_OP_RECVMSG;
+            sqe->fd = socket;
+            sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+            sqe->len = 1;
+            sqe->user_data = index;
+        }
+    }
+
+    bool NeedsArming() const
+    {
+        return multishot ? !multishotArmed : !recvToArm.empty();
+    }
+
+    void ArmWakeup()
+    {
+        io_uring_sqe* sqe = GetSqe();
+        if (sqe == nullptr)
+            return;
+
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = wakeupFd;
+        sqe->poll32_events = POLLIN;
+        sqe->user_data = WakeupTag;
+        wakeupArmed = true;
+    }
+
+    void DrainWakeup()
+    {
+        uint64_t value = 0;
+        ssize_t ignored = read(wakeupFd, &value, sizeof(value));
+        (void)ignored;
+    }
+};
+
+
+IoUringBackend::IoUringBackend()
+{
+}
+
+IoUringBackend::~IoUringBackend()
+{
+    Close();
+}
+
+bool IoUringBackend::Open(SOCKET socket, unsigned queueDepth, unsigned receiveSlots)
+{
+    Close();
+
+    auto ring = std::make_unique<Ring>();
+    ring->socket = socket;
+
+    receiveSlots = std::max(receiveSlots, 1u);
+    queueDepth = std::max(queueDepth, receiveSlots);
+
+    io_uring_params params = {};
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = queueDepth * 8;
+
+    ring->fd = SysSetup(queueDepth, &params);
+    if (ring->fd < 0)
+    {
+        std::cerr << "io_uring_setup failed: " << errno << "\n";
+        return false;
+    }
+
+    // Attente avec timeout (EXT_ARG) et anneau unique : noyaux >= 5.11
+    if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_SINGLE_MMAP))
+    {
+        std::cerr << "io_uring: fonctionnalites noyau manquantes\n";
+        return false;
+    }
+
+    ring->ringSize = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    ring->ringPtr = mmap(nullptr, ring->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (ring->ringPtr == MAP_FAILED)
+        return false;
+
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring->sqes = static_cast<io_uring_sqe*>(mmap(nullptr, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES));
+    if (ring->sqes == MAP_FAILED)
+        return false;
+
+    char* base = static_cast<char*>(ring->ringPtr);
+    ring->sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+    ring->sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+    ring->sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+    ring->sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+    ring->sqEntries = params.sq_entries;
+    ring->sqLocalTail = *ring->sqTail;
+
+    ring->cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+    ring->cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+    ring->cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+    ring->cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+
+    // Multishot si l'anneau de tampons fournis s'enregistre, sinon RECVMSG simples
+    ring->slotCount = receiveSlots;
+    ring->multishot = ring->SetupBufferRing(receiveSlots * 8);
+    if (!ring->multishot)
+        ring->EnableSlotReceives();
+
+    ring->sendSlots.resize(queueDepth);
+    ring->sendRetry.reserve(queueDepth);
+
+    // Sans eventfd, Wakeup() ne fait rien : l'attente retombe sur son timeout
+    ring->wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ring->wakeupFd >= 0)
+        ring->ArmWakeup();
+    else
+        std::cerr << "io_uring: eventfd de reveil indisponible: " << errno << "\n";
+
+    ring->ArmReceives();
+    if (ring->Submit(0, 0) < 0)
+        return false;
+
+    m_ring = std::move(ring);
+
+    // Un noyau sans recvmsg multishot (< 6.0) rejette la requete tout de suite : on le detecte ici
+    ProcessCompletions([](const char*, int, const sockaddr_in&) {});
+    if (m_ring->recvFatal)
+    {
+        std::cerr << "io_uring: recvmsg non supporte\n";
+        m_ring.reset();
+    }
+
+    return m_ring != nullptr;
+}
+
+void IoUringBackend::Close()
+{
+    m_ring.reset();
+}
+
+bool IoUringBackend::IsMultishot() const
+{
+    return m_ring && m_ring->multishot;
+}
+
+int IoUringBackend::ProcessCompletions(const ReceiveHandler& handler)
+{
+    if (!m_ring)
+        return 0;
+
+    Ring& ring = *m_ring;
+    int received = 0;
+    bool recycled = false;
+    bool fallback = false;
+
+    unsigned head = *ring.cqHead;
+    unsigned tail = LoadAcquire(ring.cqTail);
+
+    while (head != tail)
+    {
+        const io_uring_cqe& cqe = ring.cqes[head & ring.cqMask];
+
+        if (cqe.user_data >= SendTagBase && cqe.user_data < WakeupTag)
+        {
+            // Tampon d'envoi plein : SubmitSends resoumettra l'emplacement quand il aura de la place
+            if (cqe.res == -EAGAIN)
+                ring.sendRetry.push_back(static_cast<unsigned>(cqe.user_data - SendTagBase));
+            else if (cqe.res < 0)
+                ++ring.sendErrors;
+
+            if (ring.sendInFlight > 0)
+                --ring.sendInFlight;
+        }
+        else if (cqe.user_data == WakeupTag)
+        {
+            ring.DrainWakeup();
+            ring.wakeupArmed = false;
+        }
+        else if (cqe.user_data == MultishotTag)
+        {
+            if (cqe.res >= 0 && (cqe.flags & IORING_CQE_F_BUFFER))
+            {
+                unsigned bid = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+                char* buffer = ring.RingBufferAt(bid);
+
+                if (cqe.res >= static_cast<int>(sizeof(io_uring_recvmsg_out)))
+                {
+                    const auto* out = reinterpret_cast<const io_uring_recvmsg_out*>(buffer);
+                    const char* name = buffer + sizeof(io_uring_recvmsg_out);
+                    const char* payload = name + ring.multishotMsg.msg_namelen + out->controllen;
+
+                    sockaddr_in sender = {};
+                    std::memcpy(&sender, name, std::min<size_t>(out->namelen, sizeof(sender)));
+
+                    // Tronque (payloadlen reste la taille reelle) : illisible, abandonne
+                    int size = static_cast<int>(std::min<uint32_t>(out->payloadlen, MAX_PACKET_SIZE));
+                    if (out->flags & MSG_TRUNC)
+                    {
+                        ++m_truncatedDatagrams;
+                    }
+                    else if (size > 0)
+                    {
+                        handler(payload, size, sender);
+                        ++received;
+                        ++ring.multishotDelivered;
+                    }
+                }
+
+                ring.RecycleBuffer(bid);
+                recycled = true;
+            }
+
+            if (!(cqe.flags & IORING_CQE_F_MORE))
+            {
+                // Multishot arrete (tampons epuises, erreur...) : a reposter
+                ring.multishotArmed = false;
+
+                if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP)
+                {
+                    fallback = true;
+                }
+                else if (cqe.res == -ENOBUFS && ring.multishotDelivered == 0)
+                {
+                    // Anneau plein mais rien recu : les tampons fournis ne fonctionnent pas ici
+                    fallback = true;
+                }
+                else if (cqe.res < 0 && cqe.res != -ENOBUFS)
+                {
+                    std::cerr << "io_uring recvmsg error: " << -cqe.res << "\n";
+                }
+            }
+        }
+        else if (cqe.user_data < ring.recvSlots.size())
+        {
+            unsigned index = static_cast<unsigned>(cqe.user_data);
+
+            if (cqe.res > 0 && (ring.recvSlots[index].msg.msg_flags & MSG_TRUNC))
+            {
+                ++m_truncatedDatagrams;
+            }
+            else if (cqe.res > 0)
+            {
+                handler(ring.SlotBufferAt(index), cqe.res, ring.recvSlots[index].address);
+                ++received;
+            }
+            else if (cqe.res == -EINVAL || cqe.res == -EOPNOTSUPP)
+            {
+                ring.recvFatal = true;
+            }
+            else if (cqe.res < 0 && cqe.res != -EAGAIN && cqe.res != -EINTR)
+            {
+                std::cerr << "io_uring recvmsg error: " << -cqe.res << "\n";
+            }
+
+            ring.recvToArm.push_back(index);
+        }
+
+        ++head;
+        if (head == tail)
+            tail = LoadAcquire(ring.cqTail);
+    }
+
+    StoreRelease(ring.cqHead, head);
+
+    if (recycled && ring.multishot)
+        ring.PublishBuffers();
+
+    if (fallback && ring.multishot)
+    {
+        // Le datagramme refuse reste dans le socket : les RECVMSG simples le reprendront
+        std::cerr << "io_uring: recvmsg multishot indisponible, repli sur des RECVMSG simples\n";
+        ring.EnableSlotReceives();
+    }
+
+    bool rearmed = false;
+    if (!ring.recvFatal && ring.NeedsArming())
+    {
+        ring.ArmReceives();
+        rearmed = true;
+    }
+
+    if (ring.wakeupFd >= 0 && !ring.wakeupArmed)
+    {
+        ring.ArmWakeup();
+        rearmed = true;
+    }
+
+    if (rearmed)
+        ring.Submit(0, 0);
+
+    return received;
+}
+
+bool IoUringBackend::QueueSend(const char* data, int size, const sockaddr_in& address)
+{
+    if (!m_ring)
+        return false;
+
+    Ring& ring = *m_ring;
+    if (ring.sendQueued >= ring.sendSlots.size())
+        return false;
+
+    io_uring_sqe* sqe = ring.GetSqe();
+    if (sqe == nullptr)
+        return false;
+
+    const unsigned index = ring.sendQueued++;
+    Ring::SendSlot& slot = ring.sendSlots[index];
+    slot.address = address;
+    slot.iov.iov_base = const_cast<char*>(data);
+    slot.iov.iov_len = static_cast<size_t>(size);
+    slot.msg = {};
+    slot.msg.msg_name = &slot.address;
+    slot.msg.msg_namelen = sizeof(sockaddr_in);
+    slot.msg.msg_iov = &slot.iov;
+    slot.msg.msg_iovlen = 1;
+
+    ring.PrepareSend(sqe, index);
+    return true;
+}
+
+int IoUringBackend::SubmitSends(const ReceiveHandler& handler, int waitMs)
+{
+    if (!m_ring || m_ring->sendQueued == 0)
+        return 0;
+
+    Ring& ring = *m_ring;
+    ring.sendErrors = 0;
+    ring.sendRetry.clear();
+    ++m_sendSubmits;
+
+    // Un seul io_uring_enter soumet tout le lot ; les envois UDP se terminent presque toujours en ligne
+    ring.Submit(ring.sendInFlight, 0);
+
+    for (;;)
+    {
+        while (ring.sendInFlight > 0)
+        {
+            ProcessCompletions(handler);
+
+            if (ring.sendInFlight > 0)
+                ring.Submit(1, 0);
+        }
+
+        if (ring.sendRetry.empty())
+            break;
+
+        // Refuses sur -EAGAIN : attente bornee de place dans le tampon, puis meme emplacement
+        if (!Net::WaitWritable(ring.socket, waitMs))
+        {
+            std::cerr << "io_uring send: tampon d'envoi plein depuis " << waitMs << " ms, " << ring.sendRetry.size() << " datagrammes abandonnes\n";
+            ring.sendErrors += static_cast<int>(ring.sendRetry.size());
+            break;
+        }
+
+        for (unsigned index : ring.sendRetry)
+        {
+            io_uring_sqe* sqe = ring.GetSqe();
+            if (sqe == nullptr)
+                ++ring.sendErrors;
+            else
+                ring.PrepareSend(sqe, index);
+        }
+
+        ring.sendRetry.clear();
+        ring.Submit(ring.sendInFlight, 0);
+    }
+
+    // Tous les envois sont termines : les emplacements redeviennent libres
+    m_ring->sendQueued = 0;
+    return m_ring->sendErrors;
+}
+
+void IoUringBackend::Wait(int timeoutMs)
+{
+    if (!m_ring)
+        return;
+
+    Ring& ring = *m_ring;
+    if (*ring.cqHead != LoadAcquire(ring.cqTail))
+        return;
+
+    __kernel_timespec ts = {};
+    io_uring_getevents_arg arg = {};
+
+    if (timeoutMs >= 0)
+    {
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+        arg.ts = reinterpret_cast<uint64_t>(&ts);
+    }
+
+    ring.Submit(1, IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+}
+
+void IoUringBackend::Wakeup()
+{
+    if (!m_ring || m_ring->wakeupFd < 0)
+        return;
+
+    uint64_t one = 1;
+    ssize_t ignored = write(m_ring->wakeupFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+#else
+
+// ==== Stub : io_uring indisponible sur cette plateforme ====
+
+struct IoUringBackend::Ring
+{
+};
+
+IoUringBackend::IoUringBackend()
+{
+}
+
+IoUringBackend::~IoUringBackend()
+{
+}
+
+bool IoUringBackend::Open(SOCKET, unsigned, unsigned)
+{
+    return false;
+}
+
+void IoUringBackend::Close()
+{
+}
+
+bool IoUringBackend::IsMultishot() const
+{
+    return false;
+}
+
+int IoUringBackend::ProcessCompletions(const ReceiveHandler&)
+{
+    return 0;
+}
+
+bool IoUringBackend::QueueSend(const char*, int, const sockaddr_in&)
+{
+    return false;
+}
+
+int IoUringBackend::SubmitSends(const ReceiveHandler&, int)
+{
+    return 0;
+}
+
+void IoUringBackend::Wait(int)
+{
+}
+
+void IoUringBackend::Wakeup()
+{
+}
+
+#endif
@@ -0,0 +1,129 @@
+#include "RateLimiter.h"
+
+#include <algorithm>
+#include <bit>
+
+
+RateLimitConfig::RateLimitConfig()
+{
+    // Par defaut : assez large pour un client normal (ping 1/s, quelques messages)
+    for (auto& limit : limits)
+    {
+        limit = { 30.0f, 60.0f };
+    }
+
+    For(OpCode::ConnectionState) = { 2.0f, 5.0f };
+    For(OpCode::Chat) = { 5.0f, 10.0f };
+    For(OpCode::GameStart) = { 1.0f, 3.0f };
+    For(OpCode::GameData) = { 20.0f, 40.0f };
+    For(OpCode::Ping) = { 20.0f, 40.0f };
+    For(OpCode::PlayerState) = { 5.0f, 10.0f };
+
+    // Quelques octets demandent un roster (ou la table des canaux) complet : peu de jetons
+    For(OpCode::RosterResync) = { 1.0f, 3.0f };
+    For(OpCode::ChannelResync) = { 1.0f, 3.0f };
+}
+
+
+RateLimiter::RateLimiter(const RateLimitConfig& config) : m_config(config), m_origin(std::chrono::steady_clock::now())
+{
+    size_t capacity = std::bit_ceil(static_cast<size_t>(std::max(m_config.trackedSources, ProbeWindow)));
+
+    m_mask = capacity - 1;
+    m_shift = 64 - std::countr_zero(capacity);
+    m_keys.assign(capacity, EmptyKey);
+    m_entries = std::make_unique<Entry[]>(capacity);
+}
+
+bool RateLimiter::Allow(const sockaddr_in& source, int opcode)
+{
+    const int bucket = RateLimitConfig::BucketOf(opcode);
+    const RateLimit& limit = m_config.limits[bucket];
+
+    if (!m_config.enabled || limit.perSecond <= 0.0f)
+        return true;
+
+    const uint64_t key = MakeKey(source);
+    const uint32_t now = NowMs();
+
+    // Hachage de Fibonacci : les bits hauts melangent ip et port
+    size_t index = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift) & m_mask;
+
+    Entry* entry = nullptr;
+    size_t oldest = index;
+    uint32_t oldestAge = 0;
+
+    for (int probe = 0; probe < ProbeWindow; ++probe)
+    {
+        size_t slot = (index + probe) & m_mask;
+
+        if (m_keys[slot] == key)
+        {
+            entry = &m_entries[slot];
+            Refill(*entry, now);
+            break;
+        }
+
+        if (m_keys[slot] == EmptyKey)
+        {
+            m_keys[slot] = key;
+            entry = &m_entries[slot];
+            Reset(*entry, now);
+            break;
+        }
+
+        uint32_t age = now - m_entries[slot].stampMs;
+        if (age >= oldestAge)
+        {
+            oldestAge = age;
+            oldest = slot;
+        }
+    }
+
+    // Fenetre pleine : on recycle l'entree la moins recemment vue
+    if (entry == nullptr)
+    {
+        m_keys[oldest] = key;
+        entry = &m_entries[oldest];
+        Reset(*entry, now);
+    }
+
+    float& tokens = entry->tokens[bucket];
+    if (tokens < 1.0f)
+        return false;
+
+    tokens -= 1.0f;
+    return true;
+}
+
+uint32_t RateLimiter::NowMs() const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_origin);
+    return static_cast<uint32_t>(elapsed.count());
+}
+
+void RateLimiter::Reset(Entry& entry, uint32_t now)
+{
+    entry.stampMs = now;
+    for (int i = 0; i < RateLimitConfig::BucketCount; ++i)
+    {
+        entry.tokens[i] = m_config.limits[i].burst;
+    }
+}
+
+void RateLimiter::Refill(Entry& entry, uint32_t now)
+{
+    // Arithmetique modulo 2^32 : reste juste au passage du compteur
+    uint32_t elapsedMs = now - entry.stampMs;
+    if (elapsedMs == 0)
+        return;
+
+    entry.stampMs = now;
+
+    const float elapsed = static_cast<float>(elapsedMs) * 0.001f;
+    for (int i = 0; i < RateLimitConfig::BucketCount; ++i)
+    {
+        const RateLimit& limit = m_config.limits[i];
+        entry.tokens[i] = std::min(limit.burst, entry.tokens[i] + elapsed * limit.perSecond);
+    }
+}
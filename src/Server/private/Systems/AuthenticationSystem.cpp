@@ -8,59 +8,93 @@
 #include <cstdlib> // rand
 
 
+// Meme regle que l'ancien balayage : expire quand la duree en secondes entieres depasse TIMEOUT_SECONDS
+static constexpr auto TimeoutDelay = std::chrono::seconds(TIMEOUT_SECONDS + 1);
+
+
 void AuthenticationSystem::Init(GameServer* s)
 {
     this->server = s;
 
     // --- CONNECT ---
-    server->GetNetwork().OnPacket(OpCode::ConnectionState, 
-    [s](GamePacket& rawPkt, const sockaddr_in& sender)
+    server->GetNetwork().OnPacket<PacketConnectionState>(
+    [this, s](PacketConnectionState& pkt, const sockaddr_in& sender)
     {
-        PacketConnectionState pkt;
-        pkt.Deserialize(rawPkt);
-
         PlayerInfo* player = s->GetPlayerByAddr(sender);
         
         // LOGIN
         if (pkt.IsConnected) 
         {
+            // Un client qui annonce une version compacte la recoit ; sinon format historique
+            const WireFormat format = pkt.WireVersion >= 1 ? WireFormat::Compact : WireFormat::Legacy;
+
             if (!player)
             {
                 PlayerInfo newP;
                 newP.address = sender;
                 newP.pseudo = pkt.Pseudo;
+                newP.wireFormat = format;
                 newP.lastPacketTime = std::chrono::steady_clock::now();
                 newP.colorID = rand() % 8; // 8 couleurs disponibles
                 
                 auto& players = s->GetPlayers();
-                if (players.empty())
+                if (players.Empty())
                 {
                     newP.isAdmin = true;
                     std::cout << "Premier joueur " << pkt.Pseudo << " devient ADMIN." << std::endl;
                 }
 
-                for (const auto& p : players)
+                // Ancien client : un datagramme par joueur deja present (le client compact
+                // recoit le roster en snapshot plus bas)
+                if (format == WireFormat::Legacy)
                 {
-                    PacketPlayerList existingPkt;
-                    existingPkt.Pseudo = p.pseudo;
-                    existingPkt.ColorID = p.colorID;
-                    s->SendTo(sender, existingPkt);
+                    for (const auto& p : players)
+                    {
+                        PacketPlayerList existingPkt;
+                        existingPkt.Pseudo = p.pseudo;
+                        existingPkt.ColorID = p.colorID;
+                        s->SendTo(newP, existingPkt);
+                    }
                 }
 
-                players.push_back(newP);
-                player = &players.back();
+                player = &players.Add(newP);
+                ArmTimeout(*player);
                 std::cout << "Nouveau joueur : " << pkt.Pseudo << " (Admin: " << newP.isAdmin << ")" << std::endl;
             }
             else
             {
-                player->pseudo = pkt.Pseudo;
+                s->GetPlayers().Rename(*player, pkt.Pseudo);
+                player->wireFormat = format;
+            }
+
+            // Trames fiables si le client les comprend : extremite neuve, comme la sienne au login
+            if (pkt.WireVersion >= WIRE_VERSION_RELIABLE)
+                s->GetNetwork().OpenReliable(sender);
+            else
+                s->GetNetwork().CloseReliable(sender);
+
+            s->GetNetwork().SetBundling(sender, pkt.WireVersion >= WIRE_VERSION_BUNDLE);
+            s->GetNetwork().SetFragmentation(sender, pkt.WireVersion >= WIRE_VERSION_FRAGMENT);
+
+            // Canaux permanents (deja rejoints si c'est un nouveau login du meme joueur)
+            s->GetChannels().JoinDefaults(*player);
+
+            // Le client compact vide ses tables au login : ids de ses canaux, puis roster complet, lui compris
+            if (player->wireFormat == WireFormat::Compact)
+            {
+                SendChannelTable(*player);
+                SendRosterSnapshot(*player);
             }
 
             PacketConnectionState joinPkt;
             joinPkt.IsConnected = true;
             joinPkt.Pseudo = pkt.Pseudo;
             joinPkt.ColorID = player->colorID;
+            joinPkt.PlayerId = player->id;
+            joinPkt.RosterVersion = s->GetPlayers().GetVersion();
             s->Broadcast(joinPkt, &sender);
+
+            s->NotifyPlayerConnected(player->handle);
         }
         else // LOGOUT
         {
@@ -68,9 +102,33 @@ void AuthenticationSystem::Init(GameServer* s)
         }
     });
 
+    // --- ROSTER RESYNC ---
+    // Le client a vu un saut de version (diff perdu) : il repart d'un snapshot
+    server->GetNetwork().OnPacket<PacketRosterResync>(
+    [this, s](PacketRosterResync&, const sockaddr_in& sender)
+    {
+        PlayerInfo* player = s->GetPlayerByAddr(sender);
+        if (player)
+        {
+            SendRosterSnapshot(*player);
+        }
+    });
+
+    // --- CHANNEL RESYNC ---
+    // Le client a recu un id de canal inconnu (annonce perdue) : ids de tous ses canaux
+    server->GetNetwork().OnPacket<PacketChannelResync>(
+    [this, s](PacketChannelResync&, const sockaddr_in& sender)
+    {
+        PlayerInfo* player = s->GetPlayerByAddr(sender);
+        if (player && player->wireFormat == WireFormat::Compact)
+        {
+            SendChannelTable(*player);
+        }
+    });
+
     // --- PING ---
-    server->GetNetwork().OnPacket(OpCode::Ping, 
-    [s](GamePacket& rawPkt, const sockaddr_in& sender) 
+    server->GetNetwork().OnPacket<PacketPing>(
+    [s](PacketPing&, const sockaddr_in& sender) 
     {
         PlayerInfo* player = s->GetPlayerByAddr(sender);
         if (player) 
@@ -84,29 +142,91 @@ void AuthenticationSystem::Init(GameServer* s)
     });
 }
 
-void AuthenticationSystem::Update(float dt)
+void AuthenticationSystem::OnPlayerDisconnect(PlayerInfo* player)
 {
-    auto& players = server->GetPlayers();
-    auto now = std::chrono::steady_clock::now();
-    
-    for (auto it = players.begin(); it != players.end();)
+    server->GetTimers().Cancel(player->timeoutTimer);
+}
+
+void AuthenticationSystem::SendRosterSnapshot(const PlayerInfo& target)
+{
+    PlayerRegistry& players = server->GetPlayers();
+
+    // En-tete au pire : Part et PartCount au maximum, plus la longueur de la liste
+    PacketRosterSnapshot worstHeader;
+    worstHeader.Version = players.GetVersion();
+    worstHeader.Part = worstHeader.PartCount = 0xFFFF;
+    const size_t overhead = worstHeader.EncodedSize(target.wireFormat) + sizeof(uint32_t);
+
+    // Remplit chaque partie jusqu'au budget ; une entree seule trop grosse part quand meme
+    std::vector<PacketRosterSnapshot> parts(1);
+    size_t used = overhead;
+
+    for (const auto& p : players)
     {
-        // ---- timeout ----
-        auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - it->lastPacketTime);
-        if (duration.count() > TIMEOUT_SECONDS)
-        {
-            std::cout << "Timeout : " << it->pseudo << " Duration: " << duration.count() << "s" << std::endl;
-            
-            PacketConnectionState leavePkt;
-            leavePkt.IsConnected = false;
-            leavePkt.Pseudo = it->pseudo;
-            server->Broadcast(leavePkt, &it->address);
-            
-            it = players.erase(it);
-        }
-        else
+        RosterEntry entry{ p.id, p.pseudo, p.colorID };
+        const size_t entrySize = PacketCodec::ListEntrySize(entry, target.wireFormat);
+
+        if (!parts.back().Entries.empty() && used + entrySize > static_cast<size_t>(SAFE_DATAGRAM_SIZE))
         {
-            ++it;
+            parts.emplace_back();
+            used = overhead;
         }
+
+        parts.back().Entries.push_back(std::move(entry));
+        used += entrySize;
+    }
+
+    for (size_t i = 0; i < parts.size(); ++i)
+    {
+        parts[i].Version = players.GetVersion();
+        parts[i].Part = static_cast<uint16_t>(i);
+        parts[i].PartCount = static_cast<uint16_t>(parts.size());
+        server->SendTo(target, parts[i]);
+    }
+}
+
+void AuthenticationSystem::SendChannelTable(const PlayerInfo& target)
+{
+    const ChannelRegistry& channels = server->GetChannels();
+
+    for (uint16_t channelId : target.channels)
+    {
+        const ChatChannel* channel = channels.Find(channelId);
+        if (!channel)
+            continue;
+
+        PacketChannelInfo channelPkt;
+        channelPkt.ChannelId = channelId;
+        channelPkt.Name = channel->name;
+        server->SendTo(target, channelPkt);
     }
 }
+
+void AuthenticationSystem::ArmTimeout(PlayerInfo& player)
+{
+    PlayerHandle handle = player.handle;
+    player.timeoutTimer = server->GetTimers().Schedule(player.lastPacketTime + TimeoutDelay, [this, handle]
+    {
+        OnTimeout(handle);
+    });
+}
+
+void AuthenticationSystem::OnTimeout(PlayerHandle handle)
+{
+    PlayerInfo* player = server->GetPlayer(handle);
+    if (!player)
+        return;
+
+    // Actif depuis l'armement : nouvelle echeance sur le dernier paquet
+    auto now = std::chrono::steady_clock::now();
+    if (player->lastPacketTime + TimeoutDelay > now)
+    {
+        ArmTimeout(*player);
+        return;
+    }
+
+    auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - player->lastPacketTime);
+    std::cout << "Timeout : " << player->pseudo << " Duration: " << duration.count() << "s" << std::endl;
+
+    server->RemovePlayer(handle);
+}
@@ -6,16 +6,16 @@
 #include <iostream>
 #include <algorithm>
 #include <chrono>
+#include <sstream>
+#include <iomanip>
 
 
 void ChatSystem::Init(GameServer* server)
 {
     // --- CHAT PACKET ---
-    server->GetNetwork().OnPacket(OpCode::Chat, [server](GamePacket& rawPkt, const sockaddr_in& sender) 
+    // Lecture en vues : les champs pointent dans le paquet recu, valides pendant le handler
+    server->GetNetwork().OnPacket<PacketChatView>([server](PacketChatView& pkt, const sockaddr_in& sender) 
     {
-        PacketChat pkt;
-        pkt.Deserialize(rawPkt);
-
         PlayerInfo* player = server->GetPlayerByAddr(sender);
         if (player) 
         {
@@ -26,48 +26,74 @@ void ChatSystem::Init(GameServer* server)
                 return;
             }
 
+            // Un client compact designe canal et destinataire par leur id de session.
+            // Sans canal (anciens clients) : Global.
+            ChannelRegistry& channels = server->GetChannels();
+            std::string_view channelName = channels.Names().Resolve(pkt.ChannelId, pkt.ChannelName);
+            if (channelName.empty())
+                channelName = "Global";
+
+            const uint16_t channelId = static_cast<uint16_t>(channels.Names().FindId(channelName));
+
             // Private Message
-            if (!pkt.Target.empty())
+            if (pkt.TargetId != 0 || !pkt.Target.empty())
             {
-                auto& players = server->GetPlayers();
-                auto it = std::find_if(players.begin(), players.end(), [&](const PlayerInfo& p) {
-                    return p.pseudo == pkt.Target; 
-                });
-
-                if (it != players.end())
+                PlayerInfo* target = pkt.TargetId != 0 ? server->GetPlayerById(pkt.TargetId) : server->GetPlayerByPseudo(pkt.Target);
+                if (target)
                 {
-                    // To Recipient
-                    PacketChat pm;
+                    // To Recipient (encode immediatement : les vues restent valides)
+                    PacketChatView pm;
                     pm.Sender = player->pseudo;
+                    pm.SenderId = player->id;
                     pm.Message = pkt.Message;
-                    pm.Target = it->pseudo;
-                    pm.ChannelName = pkt.ChannelName;
-                    server->SendTo(it->address, pm);
+                    pm.Target = target->pseudo;
+                    pm.TargetId = target->id;
+                    pm.ChannelName = channelName;
+                    pm.ChannelId = channelId;
+
+                    // Chacun dans son format
+                    server->SendTo(*target, pm);
 
                     // To Sender
-                    server->SendTo(player->address, pm);
+                    server->SendTo(*player, pm);
 
-                    std::cout << "[WHISPER] " << player->pseudo << " -> " << it->pseudo << ": " << pkt.Message << std::endl;
+                    std::cout << "[WHISPER] " << player->pseudo << " -> " << target->pseudo << ": " << pkt.Message << std::endl;
                 }
                 else
                 {
                     PacketChat errorMsg;
                     errorMsg.Sender = "SYSTEM";
-                    errorMsg.Message = "Joueur introuvable : " + pkt.Target;
+                    errorMsg.Message = "Joueur introuvable : ";
+                    errorMsg.Message.append(pkt.Target);
                     errorMsg.ChannelName = "System";
-                    server->SendTo(player->address, errorMsg);
+                    server->SendTo(*player, errorMsg);
                 }
             }
             else
             {
-                // GLOBAL BROADCAST
-                std::cout << "[CHAT] " << player->pseudo << ": " << pkt.Message << std::endl;
-
-                PacketChat broadcastChat;
-                broadcastChat.Sender = player->pseudo;
-                broadcastChat.Message = pkt.Message;
-                broadcastChat.ChannelName = pkt.ChannelName;
-                server->Broadcast(broadcastChat);
+                // Aux seuls membres du canal, dont l'emetteur doit faire partie
+                const ChatChannel* channel = channels.Find(channelId);
+                if (!channel || !channels.IsMember(*player, channel->id))
+                {
+                    PacketChat errorMsg;
+                    errorMsg.Sender = "SYSTEM";
+                    errorMsg.Message = "Vous n'etes pas dans le canal ";
+                    errorMsg.Message.append(channelName);
+                    errorMsg.Message += " (/join <canal>)";
+                    errorMsg.ChannelName = "System";
+                    server->SendTo(*player, errorMsg);
+                    return;
+                }
+
+                std::cout << "[CHAT] #" << channel->name << " " << player->pseudo << ": " << pkt.Message << std::endl;
+
+                PacketChatView channelChat;
+                channelChat.Sender = player->pseudo;
+                channelChat.SenderId = player->id;
+                channelChat.Message = pkt.Message;
+                channelChat.ChannelName = channel->name;
+                channelChat.ChannelId = channel->id;
+                server->BroadcastToChannel(*channel, channelChat);
             }
         }
     });
@@ -80,8 +106,108 @@ void ChatSystem::Init(GameServer* server)
         
         PacketChat helpMsg;
         helpMsg.Sender = "SYSTEM";
-        helpMsg.Message = "Commandes : /help, /kick <pseudo>, /stop, /start";
-        server->SendTo(player->address, helpMsg);
+        helpMsg.Message = "Commandes : /help, /join <canal>, /leave <canal>, /room [new|<id>], /lobby, /queue [region|leave], /kick <pseudo>, /stop, /start, /netstats";
+        server->SendTo(*player, helpMsg);
+    });
+
+    server->GetCommandManager().RegisterCommand("join", [server](PlayerInfo* player, const std::vector<std::string>& args)
+    {
+        if (!player || args.empty())
+            return;
+
+        ChannelRegistry& channels = server->GetChannels();
+        uint16_t channelId = 0;
+
+        PacketChat reply;
+        reply.Sender = "SYSTEM";
+        reply.ChannelName = "System";
+
+        switch (channels.Join(*player, args[0], &channelId))
+        {
+        case ChannelRegistry::JoinResult::Joined:
+            break;
+
+        case ChannelRegistry::JoinResult::AlreadyMember:
+            reply.Message = "Deja dans le canal " + args[0];
+            server->SendTo(*player, reply);
+            return;
+
+        case ChannelRegistry::JoinResult::InvalidName:
+            reply.Message = "Nom de canal invalide (1 a " + std::to_string(ChannelRegistry::MaxNameLength) + " caracteres parmi A-Z a-z 0-9 _ -)";
+            server->SendTo(*player, reply);
+            return;
+
+        case ChannelRegistry::JoinResult::TooManyChannels:
+            reply.Message = "Trop de canaux (" + std::to_string(ChannelRegistry::MaxChannelsPerPlayer) + " au plus) : /leave <canal> d'abord";
+            server->SendTo(*player, reply);
+            return;
+
+        case ChannelRegistry::JoinResult::Full:
+            reply.Message = "Plus de canal disponible sur le serveur";
+            server->SendTo(*player, reply);
+            return;
+        }
+
+        const ChatChannel& channel = *channels.Find(channelId);
+
+        // Client compact : id du canal avant ses premiers messages
+        if (player->wireFormat == WireFormat::Compact)
+        {
+            PacketChannelInfo channelPkt;
+            channelPkt.ChannelId = channel.id;
+            channelPkt.Name = channel.name;
+            server->SendTo(*player, channelPkt);
+        }
+
+        // Par son nom (sans trames fiables, l'id pourrait arriver apres) : ouvre l'onglet du canal cote client
+        PacketChat joinMsg;
+        joinMsg.Sender = "SYSTEM";
+        joinMsg.Message = player->pseudo + " a rejoint " + channel.name + " (" + std::to_string(channel.members.size()) + " membres)";
+        joinMsg.ChannelName = channel.name;
+        server->BroadcastToChannel(channel, joinMsg);
+    });
+
+    server->GetCommandManager().RegisterCommand("leave", [server](PlayerInfo* player, const std::vector<std::string>& args)
+    {
+        if (!player || args.empty())
+            return;
+
+        ChannelRegistry& channels = server->GetChannels();
+        const ChatChannel* channel = channels.Find(std::string_view(args[0]));
+
+        PacketChat reply;
+        reply.Sender = "SYSTEM";
+        reply.ChannelName = args[0];
+
+        // Canal de salle (nom reserve) : on le quitte avec la salle
+        if (channel && !ChannelRegistry::IsValidName(channel->name))
+        {
+            reply.ChannelName = "System";
+            reply.Message = "Canal de salle : /lobby pour quitter la salle";
+            server->SendTo(*player, reply);
+            return;
+        }
+
+        if (!channel || !channels.Leave(*player, channel->id))
+        {
+            reply.ChannelName = "System";
+            reply.Message = "Vous n'etes pas dans le canal " + args[0];
+            server->SendTo(*player, reply);
+            return;
+        }
+
+        reply.Message = "Vous avez quitte " + args[0];
+        server->SendTo(*player, reply);
+
+        // Le canal a pu disparaitre avec son dernier membre
+        if (const ChatChannel* remaining = channels.Find(std::string_view(args[0])))
+        {
+            PacketChat leaveMsg;
+            leaveMsg.Sender = "SYSTEM";
+            leaveMsg.Message = player->pseudo + " a quitte " + remaining->name;
+            leaveMsg.ChannelName = remaining->name;
+            server->BroadcastToChannel(*remaining, leaveMsg);
+        }
     });
 
     server->GetCommandManager().RegisterCommand("kick", [server](PlayerInfo* requester, const std::vector<std::string>& args) 
@@ -92,7 +218,7 @@ void ChatSystem::Init(GameServer* server)
              msg.Sender = "SYSTEM"; 
              msg.Message = "Erreur: Vous n'etes pas ADMIN.";
              msg.ChannelName = "System";
-             server->SendTo(requester->address, msg);
+             server->SendTo(*requester, msg);
              return;
          }
 
@@ -100,15 +226,9 @@ void ChatSystem::Init(GameServer* server)
             return;
 
          std::string targetName = args[0];
-         auto& players = server->GetPlayers();
-        
-         auto it = std::find_if(players.begin(), players.end(), 
-            [&](const PlayerInfo& p)
-            {
-                return p.pseudo == targetName; 
-            });
+         PlayerInfo* target = server->GetPlayerByPseudo(targetName);
 
-         if (it != players.end())
+         if (target)
          {
              PacketChat kickMsg;
              kickMsg.Sender = "SYSTEM";
@@ -116,7 +236,39 @@ void ChatSystem::Init(GameServer* server)
              kickMsg.ChannelName = "System";
              server->Broadcast(kickMsg);
 
-             server->RemovePlayer(it->address);
+             server->RemovePlayer(sockaddr_in(target->address));
+         }
+    });
+
+    server->GetCommandManager().RegisterCommand("netstats", [server](PlayerInfo* requester, const std::vector<std::string>& args)
+    {
+         if (!requester || !requester->isAdmin)
+            return;
+
+         NetworkStats stats = server->GetNetwork().GetStats();
+         double avgBatch = stats.receiveBatches ? static_cast<double>(stats.receivedDatagrams) / static_cast<double>(stats.receiveBatches) : 0.0;
+
+         std::ostringstream ss;
+         ss << "Reception : " << stats.receivedDatagrams << " paquets / " << stats.receiveBatches << " lots (moy. "
+            << std::fixed << std::setprecision(1) << avgBatch << ", pleins " << stats.fullBatches << ", perdus " << stats.queueDrops << ", tronques " << stats.truncatedDatagrams << ", limites " << stats.rateLimited << ", inconnus " << stats.unknownPackets << ", malformes " << stats.malformedPackets << ") | remplissage :";
+
+         for (int i = 0; i < NetworkStats::BatchHistogramSize; ++i)
+         {
+             ss << " " << (1 << i) << (i + 1 < NetworkStats::BatchHistogramSize ? "" : "+") << "=" << stats.batchFill[i];
          }
+
+         ss << " | envoi : " << stats.sentDatagrams << " paquets / " << stats.sendBatches << " lots, erreurs " << stats.sendErrors
+            << ", groupes " << stats.bundles << " (" << stats.bundledPackets << " paquets), fragmentes " << stats.fragmentedPackets
+            << " (" << stats.fragments << " fragments, trop gros " << stats.oversizedPackets << ")";
+         ss << " | fiable : " << stats.reliablePeers << " pairs, trames " << stats.reliable.sentFrames << " (retransmises " << stats.reliable.retransmits
+            << ", acks seuls " << stats.reliable.ackOnlyFrames << "), livres " << stats.reliable.delivered << ", doublons " << stats.reliable.duplicates
+            << ", hors fenetre " << stats.reliable.outOfWindow << ", file pleine " << stats.reliable.queueFull << ", refusees " << stats.rejectedFrames;
+         ss << " | tampons alloues : " << PacketBufferPool::Allocations();
+
+         PacketChat msg;
+         msg.Sender = "SYSTEM";
+         msg.Message = ss.str();
+         msg.ChannelName = "System";
+         server->SendTo(*requester, msg);
     });
 }
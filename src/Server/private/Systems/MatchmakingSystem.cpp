@@ -0,0 +1,172 @@
+#include "Systems/MatchmakingSystem.h"
+#include "Systems/MiniGameSystem.h"
+#include "Core/GameServer.h"
+
+#include "PacketSystem.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+
+MatchmakingSystem::MatchmakingSystem(MiniGameSystem* games, const MatchmakingConfig& config)
+    : m_games(games), m_queue(config)
+{
+}
+
+void MatchmakingSystem::Init(GameServer* server)
+{
+    m_server = server;
+
+    m_games->OnRoundOver([this](uint32_t roomId, PlayerHandle winner, const std::vector<PlayerHandle>& players)
+    {
+        OnRoundOver(roomId, winner, players);
+    });
+
+    // /queue [region] : entrer en file (ou voir son attente) ; /queue leave : en sortir
+    server->GetCommandManager().RegisterCommand("queue", [this](PlayerInfo* p, const std::vector<std::string>& args)
+    {
+        if (p)
+            OnQueue(*p, args);
+    });
+}
+
+void MatchmakingSystem::Update(float dt)
+{
+    if (m_queue.Size() == 0)
+        return;
+
+    m_groups.clear();
+    if (m_queue.Form(MatchQueue::Clock::now(), m_groups) == 0)
+        return;
+
+    for (const MatchGroup& group : m_groups)
+    {
+        const uint32_t roomId = m_games->OpenMatch(group.players, m_joined);
+
+        // Refuses par leur salle (la raison leur a ete donnee) : sortis de la file, a eux de revenir
+        for (PlayerHandle handle : group.players)
+        {
+            const PlayerInfo* player = m_server->GetPlayer(handle);
+            if (player && std::find(m_joined.begin(), m_joined.end(), handle) == m_joined.end())
+                Reply(*player, "Partie trouvee, mais salle inaccessible : /queue pour revenir en file");
+        }
+
+        if (roomId == 0)
+            continue;
+
+        std::cout << "[MATCH] Salle " << roomId << " : " << m_joined.size() << "/" << group.players.size() << " joueurs, region " << group.region << ", classement moyen " << group.averageRating << std::endl;
+
+        for (PlayerHandle handle : m_joined)
+        {
+            if (const PlayerInfo* player = m_server->GetPlayer(handle))
+                Reply(*player, "Partie trouvee : salle " + std::to_string(roomId) + " (region " + group.region + ", classement moyen " + std::to_string(group.averageRating) + ")");
+        }
+
+        m_rankedRooms[roomId] = m_joined;
+    }
+}
+
+void MatchmakingSystem::OnPlayerDisconnect(PlayerInfo* player)
+{
+    m_queue.Remove(player->handle);
+}
+
+std::chrono::steady_clock::time_point MatchmakingSystem::GetNextDeadline() const
+{
+    return m_queue.NextDeadline();
+}
+
+int MatchmakingSystem::GetRating(const std::string& pseudo) const
+{
+    auto it = m_ratings.find(pseudo);
+    return it != m_ratings.end() ? it->second : InitialRating;
+}
+
+void MatchmakingSystem::OnQueue(PlayerInfo& player, const std::vector<std::string>& args)
+{
+    if (!args.empty() && args[0] == "leave")
+    {
+        Reply(player, m_queue.Remove(player.handle) ? "Vous avez quitte la file" : "Vous n'etes pas en file");
+        return;
+    }
+
+    std::string region;
+    MatchQueue::Clock::time_point queuedAt;
+    if (m_queue.Find(player.handle, &region, &queuedAt))
+    {
+        const auto waited = std::chrono::duration_cast<std::chrono::seconds>(MatchQueue::Clock::now() - queuedAt);
+        Reply(player, "En file : region " + region + ", classement " + std::to_string(GetRating(player.pseudo)) + ", " + std::to_string(waited.count()) + " s d'attente, " + std::to_string(m_queue.Size()) + " en file. /queue leave pour sortir");
+        return;
+    }
+
+    region = args.empty() ? DefaultRegion : args[0];
+    if (!MatchQueue::IsValidRegion(region))
+    {
+        Reply(player, "Region invalide : " + region + " (a-z, 0-9, " + std::to_string(MatchQueue::MaxRegionLength) + " caracteres au plus)");
+        return;
+    }
+
+    const int rating = GetRating(player.pseudo);
+    m_queue.Insert(player.handle, rating, region, MatchQueue::Clock::now());
+    Reply(player, "En file (region " + region + ", classement " + std::to_string(rating) + ") : salle de " + std::to_string(m_queue.GetConfig().roomSize) + " joueurs. /queue leave pour sortir");
+}
+
+void MatchmakingSystem::OnRoundOver(uint32_t roomId, PlayerHandle winner, const std::vector<PlayerHandle>& players)
+{
+    // Seule la premiere manche d'une salle formee est classee, entre les joueurs du groupe :
+    // 'players' (membres actifs a la fin) peut compter des arrivants par /room, ou en perdre
+    auto it = m_rankedRooms.find(roomId);
+    if (it == m_rankedRooms.end())
+        return;
+
+    const std::vector<PlayerHandle> matched = std::move(it->second);
+    m_rankedRooms.erase(it);
+
+    // Sans gagnant, ou gagne par un joueur hors du groupe : rien ne bouge
+    if (!winner.IsValid() || matched.size() < 2)
+        return;
+
+    if (std::find(matched.begin(), matched.end(), winner) == matched.end())
+        return;
+
+    const PlayerInfo* winnerInfo = m_server->GetPlayer(winner);
+    if (!winnerInfo)
+        return;
+
+    // Le gagnant bat chaque autre joueur : un duel Elo par adversaire, K reparti sur les duels
+    const double factor = static_cast<double>(RatingFactor) / static_cast<double>(matched.size() - 1);
+    const int winnerBefore = GetRating(winnerInfo->pseudo);
+    double winnerGain = 0.0;
+
+    for (PlayerHandle handle : matched)
+    {
+        const PlayerInfo* loser = m_server->GetPlayer(handle);
+        if (handle == winner || !loser)
+            continue;
+
+        const int before = GetRating(loser->pseudo);
+        const double expected = 1.0 / (1.0 + std::pow(10.0, (before - winnerBefore) / 400.0));
+        const double delta = factor * (1.0 - expected);
+
+        winnerGain += delta;
+        const int after = before - static_cast<int>(std::lround(delta));
+        m_ratings[loser->pseudo] = after;
+        Reply(*loser, "Classement : " + std::to_string(before) + " -> " + std::to_string(after));
+    }
+
+    const int winnerAfter = winnerBefore + static_cast<int>(std::lround(winnerGain));
+    m_ratings[winnerInfo->pseudo] = winnerAfter;
+    Reply(*winnerInfo, "Classement : " + std::to_string(winnerBefore) + " -> " + std::to_string(winnerAfter));
+
+    std::cout << "[MATCH] Salle " << roomId << " classee : " << winnerInfo->pseudo << " " << winnerBefore << " -> " << winnerAfter << std::endl;
+}
+
+void MatchmakingSystem::Reply(const PlayerInfo& player, std::string message)
+{
+    PacketChat msg;
+    msg.Sender = "SYSTEM";
+    msg.Message = std::move(message);
+    msg.ChannelName = "System";
+    m_server->SendTo(player, msg);
+}
@@ -0,0 +1,219 @@
+#include "Systems/MiniGameRoom.h"
+
+#include <iostream>
+#include <string>
+
+
+MiniGameRoom::MiniGameRoom(uint32_t id, uint16_t channelId, std::string channelName, RoomContext& context)
+    : m_id(id), m_channelId(channelId), m_channelName(std::move(channelName)), m_context(context), m_rng(context.rng())
+{
+}
+
+MiniGameRoom::~MiniGameRoom()
+{
+    m_context.timers.Cancel(m_roundTimer);
+}
+
+void MiniGameRoom::Handle(RoomEvent& event)
+{
+    switch (event.type)
+    {
+    case RoomEvent::Type::Join:
+        Join(std::move(event.member));
+        break;
+
+    case RoomEvent::Type::Leave:
+        Leave(event.member.handle);
+        break;
+
+    case RoomEvent::Type::Spectate:
+        if (RoomMember* member = FindMember(event.member.handle))
+        {
+            member->isSpectator = event.value != 0;
+            if (member->isSpectator)
+            {
+                std::cout << "[GAME] " << member->pseudo << " est maintenant SPECTATEUR.\n";
+                CheckActivePlayers();
+            }
+        }
+        break;
+
+    case RoomEvent::Type::Start:
+        if (!m_gameRunning)
+        {
+            StartRound();
+
+            PacketGameStart startPkt;
+            Broadcast(startPkt);
+        }
+        break;
+
+    case RoomEvent::Type::Stop:
+        EndRound();
+        Announce("Le serveur a arrete la partie.");
+        break;
+
+    case RoomEvent::Type::Guess:
+        OnGuess(event.member.handle, event.value);
+        break;
+
+    case RoomEvent::Type::Open:
+    case RoomEvent::Type::Close:
+        // Traites par le worker
+        break;
+    }
+}
+
+void MiniGameRoom::Join(RoomMember&& member)
+{
+    auto it = m_memberIndex.find(member.handle.index);
+    if (it != m_memberIndex.end())
+    {
+        // Nouveau login du meme joueur : pseudo et format ont pu changer
+        m_members[it->second] = std::move(member);
+        return;
+    }
+
+    m_memberIndex.emplace(member.handle.index, m_members.size());
+    m_members.push_back(std::move(member));
+}
+
+void MiniGameRoom::Leave(PlayerHandle handle)
+{
+    auto it = m_memberIndex.find(handle.index);
+    if (it == m_memberIndex.end() || m_members[it->second].handle != handle)
+        return;
+
+    // Retrait par echange avec le dernier, comme PlayerRegistry
+    const size_t position = it->second;
+    m_memberIndex.erase(it);
+
+    if (position + 1 != m_members.size())
+    {
+        m_members[position] = std::move(m_members.back());
+        m_memberIndex[m_members[position].handle.index] = position;
+    }
+    m_members.pop_back();
+
+    CheckActivePlayers();
+}
+
+RoomMember* MiniGameRoom::FindMember(PlayerHandle handle)
+{
+    auto it = m_memberIndex.find(handle.index);
+    if (it == m_memberIndex.end() || m_members[it->second].handle != handle)
+        return nullptr;
+
+    return &m_members[it->second];
+}
+
+void MiniGameRoom::StartRound()
+{
+    m_gameRunning = true;
+    m_mysteryNumber = m_dist(m_rng);
+    std::cout << "[SALLE " << m_id << "] Jeu Lance ! Mystere = " << m_mysteryNumber << "\n";
+
+    m_roundTimer = m_context.timers.ScheduleIn(RoundDuration, [this] { OnRoundTimeout(); });
+}
+
+void MiniGameRoom::EndRound(const RoomMember* winner)
+{
+    if (!m_gameRunning)
+        return;
+
+    m_gameRunning = false;
+    m_context.timers.Cancel(m_roundTimer);
+
+    RoomOutput& output = m_context.outputs.emplace_back();
+    output.type = RoomOutput::Type::RoundOver;
+    output.roomId = m_id;
+    if (winner)
+        output.winner = winner->handle;
+
+    for (const RoomMember& member : m_members)
+    {
+        if (!member.isSpectator)
+            output.players.push_back(member.handle);
+    }
+}
+
+void MiniGameRoom::OnRoundTimeout()
+{
+    if (!m_gameRunning)
+        return;
+
+    std::cout << "[SALLE " << m_id << "] Temps ecoule. Retour au Lobby.\n";
+    EndRound();
+
+    PacketGameEnd endPkt;
+    Broadcast(endPkt);
+
+    Announce("Temps ecoule ! Le nombre mystere etait " + std::to_string(m_mysteryNumber) + ".");
+}
+
+void MiniGameRoom::OnGuess(PlayerHandle handle, int guess)
+{
+    const RoomMember* member = FindMember(handle);
+    if (!m_gameRunning || !member)
+        return;
+
+    if (guess < m_mysteryNumber) // PLUS
+    {
+        PacketGameData response;
+        response.Value = 1;
+        SendTo(*member, response);
+    }
+    else if (guess > m_mysteryNumber) // MOINS
+    {
+        PacketGameData response;
+        response.Value = 2;
+        SendTo(*member, response);
+    }
+    else // WIN
+    {
+        PacketGameResult winPkt;
+        winPkt.WinnerName = member->pseudo;
+        winPkt.WinnerId = member->id;
+        Broadcast(winPkt);
+
+        EndRound(member);
+    }
+}
+
+void MiniGameRoom::CheckActivePlayers()
+{
+    if (!m_gameRunning)
+        return;
+
+    for (const RoomMember& member : m_members)
+    {
+        if (!member.isSpectator)
+            return;
+    }
+
+    std::cout << "[SALLE " << m_id << "] Plus de joueurs actifs. Retour au Lobby.\n";
+    EndRound();
+
+    PacketGameEnd endPkt;
+    Broadcast(endPkt);
+
+    Announce("Faute de joueurs, retour au lobby.");
+}
+
+void MiniGameRoom::Push(const RoomMember& member, const EncodedPacket& bytes, ReliableChannel channel)
+{
+    RoomOutput& output = m_context.outputs.emplace_back();
+    output.address = member.address;
+    output.packet = bytes;
+    output.channel = channel;
+}
+
+void MiniGameRoom::Announce(std::string message)
+{
+    PacketChat msg;
+    msg.Sender = "SYSTEM";
+    msg.Message = std::move(message);
+    msg.ChannelName = m_channelName;
+    msg.ChannelId = m_channelId;
+    Broadcast(msg);
+}
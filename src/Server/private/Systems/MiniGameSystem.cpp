@@ -4,141 +4,374 @@
 #include "PacketSystem.h"
 
 #include <chrono>
+#include <thread>
 #include <iostream>
+#include <algorithm>
 
 
-MiniGameSystem::MiniGameSystem() : m_gameRunning(false), m_mysteryNumber(0), m_rng(std::random_device{}()), m_dist(0, 99)
+MiniGameSystem::MiniGameSystem(int workerCount) : m_workerCount(workerCount)
+{
+    if (m_workerCount <= 0)
+        m_workerCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency() / 2));
+}
+
+MiniGameSystem::~MiniGameSystem()
 {
 }
 
 void MiniGameSystem::Init(GameServer* server)
 {
+    m_server = server;
+
+    // Les workers reveillent le thread de jeu quand ils ont des paquets a envoyer
+    m_pool = std::make_unique<RoomPool>(m_workerCount, [server] { server->GetNetwork().Wakeup(); });
+    std::cout << "Salles de jeu : " << m_pool->GetWorkerCount() << " worker(s)" << std::endl;
+
+    const ChatChannel* gameChannel = server->GetChannels().Find(std::string_view("Game"));
+
+    RoomInfo& lobby = m_rooms[LobbyRoomId];
+    lobby.id = LobbyRoomId;
+    lobby.channelId = gameChannel ? gameChannel->id : 0;
+    lobby.channelName = "Game";
+    m_pool->Open(lobby.id, lobby.channelId, lobby.channelName);
+
     // --- GAME START ---
-    server->GetNetwork().OnPacket(OpCode::GameStart, [this, server](GamePacket& rawPkt, const sockaddr_in& sender) 
+    server->GetNetwork().OnPacket<PacketGameStart>([this, server](PacketGameStart&, const sockaddr_in& sender)
     {
-        if (!m_gameRunning)
-        {
-            m_gameRunning = true;
-            m_mysteryNumber = m_dist(m_rng);
-            std::cout << "Jeu Lance ! Mystere = " << m_mysteryNumber << std::endl;
-            
-            PacketGameStart startPkt;
-            server->Broadcast(startPkt);
-        }
+        if (PlayerInfo* p = server->GetPlayerByAddr(sender))
+            Post(*p, RoomEvent::Type::Start);
     });
-    
+
     // --- PLAYER STATE (Spectator) ---
-    server->GetNetwork().OnPacket(OpCode::PlayerState, [this, server](GamePacket& rawPkt, const sockaddr_in& sender)
+    server->GetNetwork().OnPacket<PacketPlayerState>([this, server](PacketPlayerState& pkt, const sockaddr_in& sender)
     {
-        PacketPlayerState pkt;
-        pkt.Deserialize(rawPkt);
-        
         PlayerInfo* p = server->GetPlayerByAddr(sender);
         if (p)
         {
             p->isSpectator = pkt.IsSpectator;
-            if (p->isSpectator)
-            {
-                 std::cout << "[GAME] " << p->pseudo << " est maintenant SPECTATEUR." << std::endl;
-                 
-                 if (m_gameRunning)
-                 {
-                     int activeCount = 0;
-                     for(const auto& player : server->GetPlayers())
-                     {
-                         if (!player.isSpectator) 
-                             activeCount++;
-                     }
-                     
-                     if (activeCount == 0)
-                     {
-                         std::cout << "[GAME] Plus de joueurs actifs. Retour au Lobby." << std::endl;
-                         m_gameRunning = false;
-                         
-                         PacketGameEnd endPkt;
-                         server->Broadcast(endPkt);
-                         
-                         PacketChat msg;
-                         msg.Sender = "SYSTEM";
-                         msg.Message = "Faute de joueurs, retour au lobby.";
-                         msg.ChannelName = "System";
-                         server->Broadcast(msg);
-                     }
-                 }
-            }
+            Post(*p, RoomEvent::Type::Spectate, p->isSpectator ? 1 : 0);
         }
     });
 
     // --- GAME DATA ---
-    server->GetNetwork().OnPacket(OpCode::GameData, [this, server](GamePacket& rawPkt, const sockaddr_in& sender)
+    // La salle compare et repond : le thread de jeu ne fait que router
+    server->GetNetwork().OnPacket<PacketGameData>([this, server](PacketGameData& pkt, const sockaddr_in& sender)
     {
-        if (!m_gameRunning)
-            return;
-
-        PacketGameData pkt;
-        pkt.Deserialize(rawPkt);
-        
         PlayerInfo* player = server->GetPlayerByAddr(sender);
-        if (player) 
-            player->lastPacketTime = std::chrono::steady_clock::now();
-
-        int guess = pkt.Value;
-        PacketGameData response;
-        
-        if (guess < m_mysteryNumber) // PLUS
-        {
-            response.Value = 1;
-            server->SendTo(sender, response);
-        }
-        else if (guess > m_mysteryNumber) // MOINS
-        {
-            response.Value = 2;
-            server->SendTo(sender, response);
-        }
-        else // WIN
+        if (player)
         {
-            PacketGameResult winPkt;
-            winPkt.WinnerName = (player ? player->pseudo : "Unknown");
-            
-            server->Broadcast(winPkt); 
-
-            m_gameRunning = false;
+            player->lastPacketTime = std::chrono::steady_clock::now();
+            Post(*player, RoomEvent::Type::Guess, pkt.Value);
         }
     });
 
     // --- COMMANDS ---
-    server->GetCommandManager().RegisterCommand("start", [this, server](PlayerInfo* p, const std::vector<std::string>& args)
+    // Dans le lobby, partage par tous : ADMIN seulement. Dans une autre salle : tout membre.
+    server->GetCommandManager().RegisterCommand("start", [this](PlayerInfo* p, const std::vector<std::string>& args)
     {
-          if (!p || !p->isAdmin) 
+          if (!p)
+              return;
+
+          if (!p->isAdmin && p->roomId == LobbyRoomId)
           {
-             PacketChat msg; msg.Sender = "SYSTEM"; msg.Message = "Erreur: Vous n'etes pas ADMIN.";
-             server->SendTo(p->address, msg);
+             Reply(*p, "Erreur: Vous n'etes pas ADMIN.");
              return;
           }
 
-          if (!m_gameRunning) 
-          {
-              m_gameRunning = true;
-              m_mysteryNumber = m_dist(m_rng);
-              PacketGameStart startPkt;
-              server->Broadcast(startPkt);
-          }
+          Post(*p, RoomEvent::Type::Start);
     });
 
-    server->GetCommandManager().RegisterCommand("stop", [this, server](PlayerInfo* p, const std::vector<std::string>& args)
+    server->GetCommandManager().RegisterCommand("stop", [this](PlayerInfo* p, const std::vector<std::string>& args)
     {
-          if (!p || !p->isAdmin) 
+          if (!p)
+              return;
+
+          if (!p->isAdmin && p->roomId == LobbyRoomId)
           {
-             PacketChat msg; msg.Sender = "SYSTEM"; msg.Message = "Erreur: Vous n'etes pas ADMIN.";
-             server->SendTo(p->address, msg);
+             Reply(*p, "Erreur: Vous n'etes pas ADMIN.");
              return;
           }
-          
-          m_gameRunning = false;
-          PacketChat msg;
-          msg.Sender = "SYSTEM";
-          msg.Message = "Le serveur a arrete la partie.";
-          msg.ChannelName = "System";
-          server->Broadcast(msg);
+
+          Post(*p, RoomEvent::Type::Stop);
     });
+
+    // /room : salle courante ; /room new : nouvelle salle ; /room <id> : rejoindre une salle
+    server->GetCommandManager().RegisterCommand("room", [this](PlayerInfo* p, const std::vector<std::string>& args)
+    {
+        if (!p)
+            return;
+
+        if (args.empty())
+        {
+            auto it = m_rooms.find(p->roomId);
+            const size_t members = it != m_rooms.end() ? it->second.memberCount : 0;
+            Reply(*p, "Salle " + std::to_string(p->roomId) + " (" + std::to_string(members) + " joueurs), " + std::to_string(m_rooms.size()) + " salles ouvertes. /room new, /room <id>, /lobby");
+            return;
+        }
+
+        if (args[0] == "new")
+        {
+            if (RoomInfo* room = CreateRoom(*p))
+                Reply(*p, "Salle " + std::to_string(room->id) + " creee : /start pour lancer la partie");
+            return;
+        }
+
+        uint32_t roomId = 0;
+        try
+        {
+            roomId = static_cast<uint32_t>(std::stoul(args[0]));
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        auto it = m_rooms.find(roomId);
+        if (it == m_rooms.end())
+        {
+            Reply(*p, "Salle introuvable : " + args[0]);
+            return;
+        }
+
+        if (p->roomId == roomId)
+        {
+            Reply(*p, "Deja dans la salle " + args[0]);
+            return;
+        }
+
+        MoveToRoom(*p, it->second);
+    });
+
+    server->GetCommandManager().RegisterCommand("lobby", [this](PlayerInfo* p, const std::vector<std::string>& args)
+    {
+        if (p && p->roomId != LobbyRoomId)
+            MoveToRoom(*p, m_rooms[LobbyRoomId]);
+    });
+}
+
+void MiniGameSystem::Update(float dt)
+{
+    m_pool->Flush();
+
+    // Sorties deja encodees par les salles, chacune au format de son destinataire
+    NetworkServer& network = m_server->GetNetwork();
+    m_pool->Drain([this, &network](RoomOutput& output)
+    {
+        if (output.type == RoomOutput::Type::Packet)
+        {
+            network.SendTo(output.packet, output.address, output.channel);
+            return;
+        }
+
+        for (const RoundOverHandler& handler : m_roundOverHandlers)
+        {
+            handler(output.roomId, output.winner, output.players);
+        }
+    });
+}
+
+uint32_t MiniGameSystem::OpenMatch(const std::vector<PlayerHandle>& players, std::vector<PlayerHandle>& joined)
+{
+    joined.clear();
+
+    RoomInfo* room = nullptr;
+    for (PlayerHandle handle : players)
+    {
+        PlayerInfo* player = m_server->GetPlayer(handle);
+        if (!player)
+            continue;
+
+        // Le premier joueur accepte ouvre la salle (et son canal), les autres la rejoignent
+        const bool entered = room ? MoveToRoom(*player, *room) : (room = CreateRoom(*player)) != nullptr;
+        if (entered)
+            joined.push_back(handle);
+    }
+
+    if (!room)
+        return 0;
+
+    RoomEvent start;
+    start.type = RoomEvent::Type::Start;
+    start.roomId = room->id;
+    m_pool->Post(std::move(start));
+
+    // Appele apres Update() (matchmaking) : les workers n'attendent pas le tick suivant
+    m_pool->Flush();
+    return room->id;
+}
+
+void MiniGameSystem::OnPlayerConnect(PlayerInfo* player)
+{
+    // Nouveau login du meme joueur : sa salle recoit sa copie a jour (pseudo, format)
+    if (player->roomId != 0)
+    {
+        RoomEvent event;
+        event.type = RoomEvent::Type::Join;
+        event.roomId = player->roomId;
+        event.member = MakeMember(*player);
+        m_pool->Post(std::move(event));
+        return;
+    }
+
+    MoveToRoom(*player, m_rooms[LobbyRoomId]);
+}
+
+void MiniGameSystem::OnPlayerDisconnect(PlayerInfo* player)
+{
+    LeaveRoom(*player);
+}
+
+MiniGameSystem::RoomInfo* MiniGameSystem::CreateRoom(PlayerInfo& player)
+{
+    RoomInfo room;
+    room.id = m_nextRoomId++;
+    room.channelName = "Salle#" + std::to_string(room.id);
+
+    // Le canal d'abord : son id part avec l'ouverture de la salle
+    if (!JoinRoomChannel(player, room))
+        return nullptr;
+
+    room.channelId = static_cast<uint16_t>(m_server->GetChannels().Names().FindId(room.channelName));
+
+    LeaveRoom(player);
+
+    RoomInfo& created = m_rooms[room.id] = std::move(room);
+    m_pool->Open(created.id, created.channelId, created.channelName);
+
+    player.roomId = created.id;
+    created.memberCount = 1;
+
+    RoomEvent event;
+    event.type = RoomEvent::Type::Join;
+    event.roomId = created.id;
+    event.member = MakeMember(player);
+    m_pool->Post(std::move(event));
+
+    std::cout << "[SALLE " << created.id << "] ouverte par " << player.pseudo << std::endl;
+    return &created;
+}
+
+bool MiniGameSystem::MoveToRoom(PlayerInfo& player, RoomInfo& room)
+{
+    if (room.id != LobbyRoomId && !JoinRoomChannel(player, room))
+        return false;
+
+    LeaveRoom(player);
+
+    player.roomId = room.id;
+    ++room.memberCount;
+
+    RoomEvent event;
+    event.type = RoomEvent::Type::Join;
+    event.roomId = room.id;
+    event.member = MakeMember(player);
+    m_pool->Post(std::move(event));
+
+    // Le lobby est la salle de tous : pas d'annonce a chaque login
+    if (room.id != LobbyRoomId)
+    {
+        if (const ChatChannel* channel = m_server->GetChannels().Find(room.channelId))
+        {
+            PacketChat joinMsg;
+            joinMsg.Sender = "SYSTEM";
+            joinMsg.Message = player.pseudo + " a rejoint la salle " + std::to_string(room.id) + " (" + std::to_string(room.memberCount) + " joueurs)";
+            joinMsg.ChannelName = channel->name;
+            m_server->BroadcastToChannel(*channel, joinMsg);
+        }
+    }
+
+    return true;
+}
+
+void MiniGameSystem::LeaveRoom(PlayerInfo& player)
+{
+    auto it = m_rooms.find(player.roomId);
+    player.roomId = 0;
+    if (it == m_rooms.end())
+        return;
+
+    RoomInfo& room = it->second;
+
+    RoomEvent event;
+    event.type = RoomEvent::Type::Leave;
+    event.roomId = room.id;
+    event.member.handle = player.handle;
+    m_pool->Post(std::move(event));
+
+    if (room.memberCount > 0)
+        --room.memberCount;
+
+    if (room.id == LobbyRoomId)
+        return;
+
+    m_server->GetChannels().Leave(player, room.channelId);
+
+    if (room.memberCount == 0)
+    {
+        std::cout << "[SALLE " << room.id << "] fermee" << std::endl;
+        m_pool->Close(room.id);
+        m_rooms.erase(it);
+    }
+}
+
+bool MiniGameSystem::JoinRoomChannel(PlayerInfo& player, const RoomInfo& room)
+{
+    ChannelRegistry& channels = m_server->GetChannels();
+    uint16_t channelId = 0;
+
+    switch (channels.JoinReserved(player, room.channelName, &channelId))
+    {
+    case ChannelRegistry::JoinResult::Joined:
+    case ChannelRegistry::JoinResult::AlreadyMember:
+        break;
+
+    case ChannelRegistry::JoinResult::TooManyChannels:
+        Reply(player, "Trop de canaux (" + std::to_string(ChannelRegistry::MaxChannelsPerPlayer) + " au plus) : /leave <canal> avant de changer de salle");
+        return false;
+
+    default:
+        Reply(player, "Plus de canal disponible pour une salle");
+        return false;
+    }
+
+    // Client compact : id du canal de salle avant ses premiers messages
+    if (player.wireFormat == WireFormat::Compact)
+    {
+        PacketChannelInfo channelPkt;
+        channelPkt.ChannelId = channelId;
+        channelPkt.Name = room.channelName;
+        m_server->SendTo(player, channelPkt);
+    }
+
+    return true;
+}
+
+void MiniGameSystem::Post(const PlayerInfo& player, RoomEvent::Type type, int value)
+{
+    RoomEvent event;
+    event.type = type;
+    event.roomId = player.roomId;
+    event.member.handle = player.handle;
+    event.value = value;
+    m_pool->Post(std::move(event));
+}
+
+void MiniGameSystem::Reply(const PlayerInfo& player, std::string message)
+{
+    PacketChat msg;
+    msg.Sender = "SYSTEM";
+    msg.Message = std::move(message);
+    msg.ChannelName = "System";
+    m_server->SendTo(player, msg);
+}
+
+RoomMember MiniGameSystem::MakeMember(const PlayerInfo& player)
+{
+    RoomMember member;
+    member.handle = player.handle;
+    member.id = player.id;
+    member.pseudo = player.pseudo;
+    member.address = player.address;
+    member.wireFormat = player.wireFormat;
+    member.isSpectator = player.isSpectator;
+    return member;
 }
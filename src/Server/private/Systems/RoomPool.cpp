@@ -0,0 +1,221 @@
+#include "Systems/RoomPool.h"
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+
+
+static bool IsDroppable(RoomEvent::Type type)
+{
+    return type == RoomEvent::Type::Start || type == RoomEvent::Type::Stop || type == RoomEvent::Type::Guess;
+}
+
+
+RoomPool::RoomPool(int workerCount, NotifyFn notify, size_t queueCapacity) : m_notify(std::move(notify))
+{
+    workerCount = std::max(workerCount, 1);
+
+    for (int i = 0; i < workerCount; ++i)
+    {
+        auto worker = std::make_unique<Worker>(queueCapacity);
+        if (!worker->eventLoop.Open())
+        {
+            std::cerr << "RoomPool: boucle d'evenements du worker " << i << " indisponible\n";
+            continue;
+        }
+
+        m_workers.push_back(std::move(worker));
+    }
+
+    // Threads lances une fois le tableau complet : aucun worker ne le voit bouger
+    for (auto& worker : m_workers)
+    {
+        Worker* raw = worker.get();
+        worker->thread = std::thread([this, raw] { WorkerLoop(*raw); });
+    }
+}
+
+RoomPool::~RoomPool()
+{
+    m_isRunning.store(false, std::memory_order_release);
+
+    for (auto& worker : m_workers)
+    {
+        worker->eventLoop.Wakeup();
+    }
+
+    for (auto& worker : m_workers)
+    {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+bool RoomPool::Open(uint32_t roomId, uint16_t channelId, const std::string& channelName)
+{
+    if (m_workers.empty() || m_roomWorkers.count(roomId) != 0)
+        return false;
+
+    size_t index = 0;
+    for (size_t i = 1; i < m_workers.size(); ++i)
+    {
+        if (m_workers[i]->roomCount < m_workers[index]->roomCount)
+            index = i;
+    }
+
+    RoomEvent event;
+    event.type = RoomEvent::Type::Open;
+    event.roomId = roomId;
+    event.channelId = channelId;
+    event.channelName = channelName;
+
+    m_roomWorkers.emplace(roomId, index);
+    ++m_workers[index]->roomCount;
+    return PostTo(*m_workers[index], std::move(event));
+}
+
+void RoomPool::Close(uint32_t roomId)
+{
+    auto it = m_roomWorkers.find(roomId);
+    if (it == m_roomWorkers.end())
+        return;
+
+    Worker& worker = *m_workers[it->second];
+    m_roomWorkers.erase(it);
+    --worker.roomCount;
+
+    RoomEvent event;
+    event.type = RoomEvent::Type::Close;
+    event.roomId = roomId;
+    PostTo(worker, std::move(event));
+}
+
+bool RoomPool::Post(RoomEvent&& event)
+{
+    auto it = m_roomWorkers.find(event.roomId);
+    if (it == m_roomWorkers.end())
+        return false;
+
+    return PostTo(*m_workers[it->second], std::move(event));
+}
+
+bool RoomPool::PostTo(Worker& worker, RoomEvent&& event)
+{
+    worker.posted = true;
+
+    // Un evenement en attente passe avant : l'ordre d'une salle est conserve
+    if (worker.backlog.empty() && worker.inbox.TryPush(std::move(event)))
+        return true;
+
+    if (IsDroppable(event.type))
+    {
+        ++m_droppedEvents;
+        return false;
+    }
+
+    worker.backlog.push_back(std::move(event));
+    return true;
+}
+
+void RoomPool::Flush()
+{
+    for (auto& worker : m_workers)
+    {
+        size_t pushed = 0;
+        while (pushed < worker->backlog.size() && worker->inbox.TryPush(std::move(worker->backlog[pushed])))
+        {
+            ++pushed;
+        }
+        worker->backlog.erase(worker->backlog.begin(), worker->backlog.begin() + static_cast<std::ptrdiff_t>(pushed));
+
+        if (worker->posted)
+        {
+            worker->posted = false;
+            Wake(*worker);
+        }
+    }
+}
+
+void RoomPool::Wake(Worker& worker)
+{
+    // Paire avec le store de WorkerLoop : soit le worker voit l'evenement avant de dormir,
+    // soit on voit qu'il dort et on le reveille
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (worker.waiting.exchange(false, std::memory_order_acq_rel))
+        worker.eventLoop.Wakeup();
+}
+
+void RoomPool::WorkerLoop(Worker& worker)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr int MaxIdleWaitMs = 1000;
+
+    RoomEvent event;
+    while (m_isRunning.load(std::memory_order_acquire))
+    {
+        while (worker.inbox.TryPop(event))
+        {
+            Dispatch(worker, event);
+        }
+
+        auto now = Clock::now();
+        worker.context.timers.Advance(now);
+
+        if (Publish(worker))
+            m_notify();
+
+        // File de sortie pleine : on repasse vite, le thread de jeu la vide a chaque tick
+        int timeoutMs = 1;
+        if (worker.context.outputs.empty())
+        {
+            auto deadline = worker.context.timers.NextDeadline();
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+            timeoutMs = deadline == Clock::time_point::max() ? MaxIdleWaitMs : static_cast<int>(std::clamp<int64_t>((remaining.count() + 999) / 1000, 0, MaxIdleWaitMs));
+        }
+
+        worker.waiting.store(true, std::memory_order_seq_cst);
+        if (worker.inbox.Size() == 0 && timeoutMs > 0 && m_isRunning.load(std::memory_order_acquire))
+        {
+            EventLoop::Event unused[1];
+            worker.eventLoop.Wait(unused, 1, timeoutMs);
+        }
+        worker.waiting.store(false, std::memory_order_relaxed);
+    }
+}
+
+void RoomPool::Dispatch(Worker& worker, RoomEvent& event)
+{
+    switch (event.type)
+    {
+    case RoomEvent::Type::Open:
+        worker.rooms[event.roomId] = std::make_unique<MiniGameRoom>(event.roomId, event.channelId, std::move(event.channelName), worker.context);
+        break;
+
+    case RoomEvent::Type::Close:
+        worker.rooms.erase(event.roomId);
+        break;
+
+    default:
+    {
+        auto it = worker.rooms.find(event.roomId);
+        if (it != worker.rooms.end())
+            it->second->Handle(event);
+        break;
+    }
+    }
+}
+
+bool RoomPool::Publish(Worker& worker)
+{
+    std::vector<RoomOutput>& outputs = worker.context.outputs;
+
+    size_t pushed = 0;
+    while (pushed < outputs.size() && worker.outbox.TryPush(std::move(outputs[pushed])))
+    {
+        ++pushed;
+    }
+    outputs.erase(outputs.begin(), outputs.begin() + static_cast<std::ptrdiff_t>(pushed));
+
+    return pushed > 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "PlayerRegistry.h"
+#include "NameTable.h"
+
+
+struct ChatChannel
+{
+    uint16_t id = 0;          // id de session (0 = emplacement libre)
+    std::string name;
+    bool isDefault = false;   // rejoint au login, garde meme vide
+    std::vector<PlayerHandle> members;
+};
+
+
+// ==== Canaux de chat et leurs abonnes ====
+// Un message de canal ne part qu'a ses membres : le cout d'envoi suit la taille du canal, pas celle
+// du serveur. Chaque canal garde ses membres (handles), chaque joueur les ids de ses canaux
+// (PlayerInfo::channels) : rejoindre, quitter et partir se font sans parcourir tous les joueurs.
+// Un canal cree par /join disparait avec son dernier membre ; son id n'est reattribue qu'apres
+// tous les autres, pour qu'un client ne confonde pas un ancien canal avec un nouveau.
+class ChannelRegistry
+{
+public:
+    static constexpr size_t MaxNameLength = 24;
+    static constexpr size_t MaxChannelsPerPlayer = 16;
+
+    enum class JoinResult
+    {
+        Joined,
+        AlreadyMember,
+        InvalidName,        // vide, trop long ou caractere hors [A-Za-z0-9_-]
+        TooManyChannels,    // le joueur est deja dans MaxChannelsPerPlayer canaux
+        Full                // plus d'id de session libre
+    };
+
+    // Canal permanent, rejoint par chaque joueur au login
+    uint16_t AddDefault(std::string_view name);
+
+    // Cree le canal au besoin. 'channelId' recoit l'id du canal (rejoint ou deja membre).
+    JoinResult Join(PlayerInfo& player, std::string_view name, uint16_t* channelId = nullptr);
+    void JoinDefaults(PlayerInfo& player);
+
+    // Canal tenu par le serveur (salle de jeu) : son nom sort de IsValidName, /join ne l'atteint pas
+    JoinResult JoinReserved(PlayerInfo& player, std::string_view name, uint16_t* channelId = nullptr);
+
+    // false si le joueur n'en est pas membre
+    bool Leave(PlayerInfo& player, uint16_t channelId);
+    void LeaveAll(PlayerInfo& player);
+
+    // nullptr si inconnu
+    const ChatChannel* Find(uint16_t channelId) const;
+    const ChatChannel* Find(std::string_view name) const;
+
+    bool IsMember(const PlayerInfo& player, uint16_t channelId) const;
+    static bool IsValidName(std::string_view name);
+
+    // Ids de session des canaux existants (annonces aux clients compacts)
+    const NameTable& Names() const { return m_names; }
+
+private:
+    JoinResult JoinChecked(PlayerInfo& player, std::string_view name, uint16_t* channelId);
+    ChatChannel* Create(std::string_view name);
+    uint16_t NextFreeId();
+
+    // Indexe par id : m_channels[id].id == id si le canal existe
+    std::vector<ChatChannel> m_channels;
+    NameTable m_names;
+    std::vector<uint16_t> m_defaults;
+    uint16_t m_nextId = 1;
+};
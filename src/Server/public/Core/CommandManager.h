@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <functional>
@@ -16,7 +17,8 @@ public:
     CommandManager(GameServer* server);
 
     void RegisterCommand(const std::string& command, CommandHandler handler);
-    bool ProcessCommand(PlayerInfo* player, const std::string& message);
+    // false (sans allocation) si le message n'est pas une commande
+    bool ProcessCommand(PlayerInfo* player, std::string_view message);
 
 private:
     GameServer* m_server;
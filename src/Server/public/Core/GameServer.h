@@ -3,60 +3,134 @@
 #include <vector>
 #include <chrono>
 #include <string>
+#include <utility>
 
 #include "Systems/IServerSystem.h"
 #include "NetworkServer.h"
 #include "CommandManager.h"
+#include "PlayerRegistry.h"
+#include "ChannelRegistry.h"
+#include "TimerWheel.h"
+#include "MatchQueue.h"
 #include "PacketSystem.h"
 
 class CommandManager;
 
 
-struct PlayerInfo
-{
-    sockaddr_in address = {};
-    std::string pseudo = "";
-    std::chrono::steady_clock::time_point lastPacketTime = {};
-    bool isAdmin = false;
-    uint8_t colorID = 0;
-    bool isSpectator = false;
-};
-
 class GameServer
 {
 public:
     GameServer();
     ~GameServer();
 
-    bool Initialize();
+    // roomWorkers : threads des salles de jeu (<= 0 : selon le nombre de coeurs)
+    bool Initialize(const NetworkServerConfig& networkConfig = {}, int roomWorkers = 0, const MatchmakingConfig& matchmaking = {});
     void Run();
 
     NetworkServer& GetNetwork() { return m_network; }
     CommandManager& GetCommandManager() { return m_commandManager; }
-    std::vector<PlayerInfo>& GetPlayers() { return m_players; }
+    PlayerRegistry& GetPlayers() { return m_players; }
+    TimerWheel& GetTimers() { return m_timers; }
 
-    template <typename T>
-    T* AddSystem()
+    // Canaux de chat, leurs membres et leurs ids de session (annonces aux clients compacts)
+    ChannelRegistry& GetChannels() { return m_channels; }
+
+    template <typename T, typename... Args>
+    T* AddSystem(Args&&... args)
     {
-        auto system = std::make_unique<T>();
+        auto system = std::make_unique<T>(std::forward<Args>(args)...);
         T* systemPtr = system.get();
         m_systems.push_back(std::move(system));
         return systemPtr;
     }
 
+    // Broadcast serialise une seule fois par format utilise (historique / compact) puis diffuse
+    // le meme tampon a chaque joueur de ce format. Un EncodedPacket part tel quel a tous.
     void Broadcast(const IPacket& pkt, const sockaddr_in* senderToIgnore = nullptr);
+    void Broadcast(const EncodedPacket& pkt, const sockaddr_in* senderToIgnore = nullptr);
+
+    // Vers une adresse : au format du joueur qui l'occupe (historique si inconnue)
     void SendTo(const sockaddr_in& target, const IPacket& pkt);
+    void SendTo(const sockaddr_in& target, const EncodedPacket& pkt);
+    void SendTo(const PlayerInfo& target, const IPacket& pkt);
+
+    // Paquets concrets : codec statique, sans passer par IPacket
+    template <StaticPacket PacketT>
+    void Broadcast(const PacketT& pkt, const sockaddr_in* senderToIgnore = nullptr)
+    {
+        BroadcastPerFormat([&pkt](WireFormat format) { return EncodePacket(pkt, format); }, PacketT::Channel, senderToIgnore);
+    }
+
+    // Aux seuls membres du canal, encode une fois par format comme Broadcast
+    template <StaticPacket PacketT>
+    void BroadcastToChannel(const ChatChannel& channel, const PacketT& pkt)
+    {
+        EncodedPacket encoded[WireFormatCount];
+        auto encode = [&pkt](WireFormat format) { return EncodePacket(pkt, format); };
+
+        for (PlayerHandle handle : channel.members)
+        {
+            if (const PlayerInfo* member = m_players.Get(handle))
+                SendPerFormat(*member, encoded, encode, PacketT::Channel);
+        }
+    }
+
+    template <StaticPacket PacketT>
+    void SendTo(const sockaddr_in& target, const PacketT& pkt) { m_network.SendTo(pkt, target, FormatOf(target)); }
+
+    template <StaticPacket PacketT>
+    void SendTo(const PlayerInfo& target, const PacketT& pkt) { m_network.SendTo(pkt, target.address, target.wireFormat); }
     
     PlayerInfo* GetPlayerByAddr(const sockaddr_in& addr);
+    PlayerInfo* GetPlayerByPseudo(std::string_view pseudo);
+    PlayerInfo* GetPlayer(PlayerHandle handle) { return m_players.Get(handle); }
+    PlayerInfo* GetPlayerById(uint32_t id) { return m_players.FindById(id); }
+
+    // Login termine (AuthenticationSystem) : previent les systemes (OnPlayerConnect)
+    void NotifyPlayerConnected(PlayerHandle handle);
+
+    // Seul chemin de sortie d'un joueur : previent les systemes (OnPlayerDisconnect) avant le retrait
+    void RemovePlayer(PlayerHandle handle);
     void RemovePlayer(const sockaddr_in& addr);
 
 private:
     void HandlePacket(GamePacket& pkt, const sockaddr_in& sender);
+
+    WireFormat FormatOf(const sockaddr_in& address);
+
+    // encode(format) -> EncodedPacket, appele au plus une fois par format present.
+    // Les pairs fiables recoivent ces memes octets dans une trame a eux (channel).
+    template <typename EncodeFn>
+    void BroadcastPerFormat(EncodeFn&& encode, ReliableChannel channel, const sockaddr_in* senderToIgnore)
+    {
+        EncodedPacket encoded[WireFormatCount];
+
+        for (auto& p : m_players)
+        {
+            if (senderToIgnore != nullptr && p.address.sin_addr.s_addr == senderToIgnore->sin_addr.s_addr && p.address.sin_port == senderToIgnore->sin_port)
+                continue;
+
+            SendPerFormat(p, encoded, encode, channel);
+        }
+    }
+
+    // encoded[format] : encode au premier destinataire de ce format, partage ensuite
+    template <typename EncodeFn>
+    void SendPerFormat(const PlayerInfo& p, EncodedPacket (&encoded)[WireFormatCount], EncodeFn& encode, ReliableChannel channel)
+    {
+        EncodedPacket& bytes = encoded[static_cast<int>(p.wireFormat)];
+        if (!bytes)
+            bytes = encode(p.wireFormat);
+
+        m_network.SendTo(bytes, p.address, channel);
+    }
     
     NetworkServer m_network;
     CommandManager m_commandManager;
     
-    std::vector<PlayerInfo> m_players;
+    PlayerRegistry m_players;
+    TimerWheel m_timers;
+    ChannelRegistry m_channels;
 
     std::vector<std::unique_ptr<IServerSystem>> m_systems;
 };
\ No newline at end of file
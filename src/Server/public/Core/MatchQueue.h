@@ -0,0 +1,119 @@
+#pragma once
+#include <set>
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <unordered_map>
+#include <cstdint>
+
+#include "PlayerRegistry.h"
+
+
+struct MatchmakingConfig
+{
+    // Joueurs par salle formee
+    int roomSize = 4;
+
+    // Ecart de classement accepte dans un groupe : initial, gagne par seconde d'attente, plafond
+    int baseSpread = 100;
+    int spreadPerSecond = 25;
+    int maxSpread = 400;
+};
+
+
+// Groupe forme : meme region, ecart de classement accepte par chacun de ses joueurs
+struct MatchGroup
+{
+    std::string region;
+    std::vector<PlayerHandle> players;
+    int averageRating = 0;
+};
+
+
+// ==== File d'attente de matchmaking ====
+// Un ensemble ordonne (classement, ordre d'arrivee) par region : entree et sortie en O(log n).
+// Form() travaille par increments : chaque nouvel arrivant ne regarde que ses voisins de
+// classement (les fenetres de roomSize joueurs consecutifs qui le contiennent). Une fois par
+// SweepInterval, un balayage complet rattrape les joueurs dont la tolerance a grandi en attendant.
+// Ecart d'un groupe = classement max - min ; il doit tenir dans la tolerance de chacun de ses joueurs.
+class MatchQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto SweepInterval = std::chrono::seconds(1);
+    static constexpr size_t MaxRegionLength = 8;
+
+    explicit MatchQueue(const MatchmakingConfig& config = {});
+
+    // false si le joueur est deja en file (ou la region invalide)
+    bool Insert(PlayerHandle player, int rating, std::string_view region, Clock::time_point now);
+    bool Remove(PlayerHandle player);
+    bool Contains(PlayerHandle player) const;
+
+    // Region et debut d'attente d'un joueur en file (false sinon)
+    bool Find(PlayerHandle player, std::string* region, Clock::time_point* queuedAt) const;
+
+    // Ajoute a 'groups' les groupes formes a 'now' (retires de la file). Retourne leur nombre.
+    size_t Form(Clock::time_point now, std::vector<MatchGroup>& groups);
+
+    // Prochain balayage utile (max() si la file est vide)
+    Clock::time_point NextDeadline() const;
+
+    size_t Size() const { return m_entries.size(); }
+    const MatchmakingConfig& GetConfig() const { return m_config; }
+
+    static bool IsValidRegion(std::string_view region);
+
+private:
+    struct Ticket
+    {
+        int rating = 0;
+        uint64_t order = 0;
+        PlayerHandle player;
+        Clock::time_point queuedAt;
+
+        bool operator<(const Ticket& other) const
+        {
+            return rating != other.rating ? rating < other.rating : order < other.order;
+        }
+    };
+
+    struct Bucket
+    {
+        std::string region;
+        std::set<Ticket> tickets;
+        std::vector<Ticket> fresh;   // arrives depuis le dernier Form
+    };
+
+    struct Entry
+    {
+        Bucket* bucket = nullptr;
+        Ticket ticket;
+    };
+
+    using Iterator = std::set<Ticket>::const_iterator;
+
+    static uint64_t KeyOf(PlayerHandle player) { return (static_cast<uint64_t>(player.index) << 32) | player.generation; }
+
+    int Tolerance(const Ticket& ticket, Clock::time_point now) const;
+
+    // Fenetre de roomSize tickets a partir de 'first' : false si elle sort du seau ou depasse une tolerance
+    bool Fits(const Bucket& bucket, Iterator first, Clock::time_point now, int* spread) const;
+
+    // Meilleure fenetre contenant 'ticket' (plus petit ecart). false si aucune ne tient.
+    bool FormAround(Bucket& bucket, const Ticket& ticket, Clock::time_point now, std::vector<MatchGroup>& groups);
+    size_t Sweep(Bucket& bucket, Clock::time_point now, std::vector<MatchGroup>& groups);
+    Iterator Take(Bucket& bucket, Iterator first, std::vector<MatchGroup>& groups);
+
+    MatchmakingConfig m_config;
+
+    // Un seau par region en file, rendu des qu'il se vide : les Entry gardent un pointeur stable
+    std::unordered_map<std::string, std::unique_ptr<Bucket>> m_buckets;
+    std::unordered_map<uint64_t, Entry> m_entries;
+
+    uint64_t m_nextOrder = 0;
+    Clock::time_point m_nextSweep = {};
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+
+#include "NetworkCommon.h"
+#include "TimerWheel.h"
+
+
+// Reference stable vers un joueur : reste verifiable apres son depart (la generation ne correspond plus)
+struct PlayerHandle
+{
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != InvalidIndex; }
+    bool operator==(const PlayerHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const PlayerHandle& other) const { return !(*this == other); }
+};
+
+
+struct PlayerInfo
+{
+    sockaddr_in address = {};
+    std::string pseudo = "";
+    std::chrono::steady_clock::time_point lastPacketTime = {};
+    bool isAdmin = false;
+    uint8_t colorID = 0;
+    bool isSpectator = false;
+
+    // Format des paquets envoyes a ce joueur (negocie au login)
+    WireFormat wireFormat = WireFormat::Legacy;
+
+    // Minuteur d'inactivite (AuthenticationSystem)
+    TimerHandle timeoutTimer;
+
+    // Ids des canaux de chat rejoints (tenus par ChannelRegistry)
+    std::vector<uint16_t> channels;
+
+    // Salle de jeu courante (MiniGameSystem, 0 = aucune)
+    uint32_t roomId = 0;
+
+    // Attribues par PlayerRegistry::Add
+    PlayerHandle handle;
+    uint16_t id = 0;          // id de session annonce aux clients compacts (0 = aucun)
+    uint64_t joinOrder = 0;   // ordre d'arrivee : sert a designer le prochain admin
+};
+
+
+// ==== Registre des joueurs (slot map generationnelle) ====
+// Les joueurs vivent dans un tableau dense (iteration rapide a chaque tick). Une table de slots
+// fait le lien handle -> position dense ; chaque slot porte une generation incrementee a la
+// liberation, ce qui rend les anciens handles detectables. Ajout et retrait en O(1) : le retrait
+// deplace le dernier joueur dans la case liberee et met a jour son slot.
+// Index secondaires : adresse (ip, port) empaquetee sur 64 bits et pseudo, vers des handles.
+// Les PlayerInfo* ne survivent pas a Add/Remove : garder un PlayerHandle entre deux appels.
+class PlayerRegistry
+{
+public:
+    using AddressKey = uint64_t;
+
+    static AddressKey MakeKey(const sockaddr_in& address)
+    {
+        return (static_cast<uint64_t>(address.sin_addr.s_addr) << 16) | address.sin_port;
+    }
+
+    // L'adresse ne doit pas deja etre enregistree
+    PlayerInfo& Add(const PlayerInfo& player);
+    bool Remove(PlayerHandle handle);
+    bool Remove(const sockaddr_in& address);
+    void Clear();
+
+    // nullptr si le handle est perime
+    PlayerInfo* Get(PlayerHandle handle);
+    bool IsAlive(PlayerHandle handle) const;
+
+    PlayerInfo* Find(const sockaddr_in& address);
+    PlayerInfo* FindByPseudo(std::string_view pseudo);
+
+    // Par id de session : le joueur qui occupe actuellement ce slot
+    PlayerInfo* FindById(uint32_t id);
+
+    // Change le pseudo en gardant l'index a jour
+    void Rename(PlayerInfo& player, const std::string& pseudo);
+
+    // Joueur present depuis le plus longtemps (nullptr si vide)
+    PlayerInfo* Oldest();
+
+    // Avance a chaque ajout, retrait ou changement de pseudo : numerote les diffs du roster
+    uint32_t GetVersion() const { return m_version; }
+
+    size_t Size() const { return m_players.size(); }
+    bool Empty() const { return m_players.empty(); }
+
+    std::vector<PlayerInfo>::iterator begin() { return m_players.begin(); }
+    std::vector<PlayerInfo>::iterator end() { return m_players.end(); }
+    std::vector<PlayerInfo>::const_iterator begin() const { return m_players.begin(); }
+    std::vector<PlayerInfo>::const_iterator end() const { return m_players.end(); }
+
+private:
+    struct Slot
+    {
+        uint32_t generation = 0;
+        uint32_t dense = 0;   // position dans m_players si occupe, slot libre suivant sinon
+    };
+
+    // Recherche par string_view sans construire de std::string
+    struct PseudoHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view pseudo) const { return std::hash<std::string_view>{}(pseudo); }
+    };
+
+    void UnindexPseudo(const std::string& pseudo, PlayerHandle handle);
+
+    std::vector<PlayerInfo> m_players;
+    std::vector<Slot> m_slots;
+    uint32_t m_freeSlot = PlayerHandle::InvalidIndex;
+
+    std::unordered_map<AddressKey, PlayerHandle> m_byAddress;
+
+    // Deux connexions peuvent porter le meme pseudo : la recherche rend la premiere arrivee
+    std::unordered_multimap<std::string, PlayerHandle, PseudoHash, std::equal_to<>> m_byPseudo;
+
+    uint64_t m_nextJoinOrder = 0;
+
+    // 0 est reserve a "sans version" sur le fil
+    uint32_t m_version = 1;
+};
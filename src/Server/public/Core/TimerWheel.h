@@ -0,0 +1,88 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+
+// Reference vers un minuteur : perimee des qu'il a expire ou ete annule
+struct TimerHandle
+{
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+    uint32_t index = InvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != InvalidIndex; }
+};
+
+
+// ==== Roue de minuteurs hierarchique ====
+// 4 niveaux de 64 cases ; une case du niveau 0 couvre TickDuration, une case du niveau n
+// couvre 64^n ticks. Un minuteur est range selon son eloignement puis redescend d'un niveau
+// a chaque tour de la roue inferieure (cascade). Ajout, annulation et replanification en O(1) ;
+// Advance() ne touche que les cases echues et les minuteurs qui expirent.
+// Precision : un minuteur part au plus TickDuration apres son echeance, jamais avant.
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    static constexpr Clock::duration TickDuration = std::chrono::milliseconds(10);
+    static constexpr int LevelBits = 6;
+    static constexpr int SlotsPerLevel = 1 << LevelBits;
+    static constexpr int LevelCount = 4;
+
+    TimerWheel();
+
+    TimerHandle Schedule(Clock::time_point when, Callback callback);
+    TimerHandle ScheduleIn(Clock::duration delay, Callback callback) { return Schedule(Clock::now() + delay, std::move(callback)); }
+
+    // Deplace l'echeance d'un minuteur encore actif (false s'il a deja expire ou ete annule)
+    bool Reschedule(TimerHandle handle, Clock::time_point when);
+    bool Cancel(TimerHandle handle);
+    bool IsActive(TimerHandle handle) const;
+
+    // Declenche tous les minuteurs echus a 'now'. Les callbacks peuvent planifier ou annuler.
+    void Advance(Clock::time_point now);
+
+    // Borne inferieure de la prochaine echeance (max() si aucun minuteur) : a utiliser
+    // comme timeout d'attente, Advance() fera les cascades necessaires au reveil.
+    Clock::time_point NextDeadline() const;
+
+    size_t Size() const { return m_activeCount; }
+
+private:
+    static constexpr uint32_t None = 0xFFFFFFFFu;
+
+    struct Timer
+    {
+        Clock::time_point when;
+        uint64_t expiryTick = 0;
+        Callback callback;
+
+        uint32_t generation = 0;
+        uint32_t prev = None;
+        uint32_t next = None;   // suivant dans la case, ou minuteur libre suivant
+        uint16_t slot = 0;      // niveau * SlotsPerLevel + case
+        bool active = false;
+    };
+
+    uint64_t TickOf(Clock::time_point when) const;
+    void Insert(uint32_t index, uint64_t minTick);
+    void Unlink(uint32_t index);
+    void Release(uint32_t index);
+    void Cascade(int level, uint64_t tick);
+    void ProcessTick(uint64_t tick);
+
+    Clock::time_point m_origin;
+    uint64_t m_currentTick = 0;   // dernier tick traite
+
+    std::vector<Timer> m_timers;
+    uint32_t m_freeTimer = None;
+    size_t m_activeCount = 0;
+
+    uint32_t m_slots[LevelCount * SlotsPerLevel];
+    uint64_t m_occupied[LevelCount] = {};   // un bit par case non vide
+};
@@ -1,19 +1,109 @@
 #pragma once
-#include <winsock2.h>
-#include <ws2tcpip.h>
 #include <vector>
 #include <string>
 #include <functional>
-#include <map>
-#include <queue>
 #include <thread>
-#include <mutex>
 #include <atomic>
+#include <memory>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
 
 
 
 #include "PacketSystem.h"
-#pragma comment(lib, "ws2_32.lib")
+#include "PacketDispatcher.h"
+#include "ReliableEndpoint.h"
+#include "RingBuffer.h"
+#include "RateLimiter.h"
+#include "Platform/EventLoop.h"
+#include "Platform/IoUringBackend.h"
+
+
+enum class NetworkBackend
+{
+    Workers,    // Threads de reception (epoll/poll) + files vers le thread de jeu
+    IoUring     // Completions io_uring traitees par le thread de jeu (repli sur Workers si indisponible)
+};
+
+
+struct NetworkServerConfig
+{
+    NetworkBackend backend = NetworkBackend::Workers;
+
+    // Datagrammes lus par appel systeme (recvmmsg sous Linux). 1 = un recvfrom par datagramme.
+    int receiveBatchSize = 32;
+
+    // Threads de reception, chacun avec son socket SO_REUSEPORT et sa file.
+    // Le noyau repartit par 4-uplet : un meme expediteur reste sur le meme shard.
+    // Ramene a 1 la ou SO_REUSEPORT ne repartit pas la charge (hors Linux).
+    int receiveWorkers = 1;
+
+    // Paquets en attente par shard. File pleine = paquet abandonne et compte (queueDrops).
+    int receiveQueueCapacity = 4096;
+
+    // Datagrammes envoyes par appel systeme lors de FlushSends (sendmmsg sous Linux)
+    int sendBatchSize = 64;
+
+    // Tampon d'envoi plein (socket non bloquant) : FlushSends attend jusqu'a ce delai qu'il se
+    // vide puis reprend au datagramme refuse. Au-dela, le reste du tick est abandonne et compte.
+    int sendWaitMs = 50;
+
+    // Regroupe les paquets d'un meme tick vers un meme pair (qui a annonce WIRE_VERSION_BUNDLE)
+    // en datagrammes d'au plus SAFE_DATAGRAM_SIZE : un en-tete UDP/IP et une entree sendmmsg pour tous
+    bool coalesceSends = true;
+
+    // Seaux a jetons par adresse source, verifies avant toute copie ou mise en file
+    RateLimitConfig rateLimits;
+};
+
+
+// ==== Compteurs de reception ====
+struct NetworkStats
+{
+    static constexpr int BatchHistogramSize = 8;
+
+    uint64_t receiveBatches = 0;
+    uint64_t receivedDatagrams = 0;
+    uint64_t fullBatches = 0;
+    uint64_t queueDrops = 0;
+
+    // Datagrammes plus grands que MAX_PACKET_SIZE, tronques par le noyau et abandonnes (recvmmsg)
+    uint64_t truncatedDatagrams = 0;
+
+    // Paquets refuses par le limiteur de debit, au total et par OpCode (dernier seau : autres)
+    uint64_t rateLimited = 0;
+    uint64_t rateLimitedByOpCode[RateLimitConfig::BucketCount] = {};
+
+    // Paquets abandonnes a la distribution : OpCode sans handler, contenu tronque
+    uint64_t unknownPackets = 0;
+    uint64_t malformedPackets = 0;
+
+    uint64_t sendBatches = 0;
+    uint64_t sentDatagrams = 0;
+    uint64_t sendErrors = 0;
+
+    // Datagrammes groupes envoyes, paquets partis dans un groupe (au lieu d'un datagramme chacun)
+    uint64_t bundles = 0;
+    uint64_t bundledPackets = 0;
+
+    // Paquets plus grands que SAFE_DATAGRAM_SIZE decoupes, fragments envoyes,
+    // paquets abandonnes car au-dela de Fragment::MaxMessageSize
+    uint64_t fragmentedPackets = 0;
+    uint64_t fragments = 0;
+    uint64_t oversizedPackets = 0;
+
+    // Couche fiable : pairs negocies, cumul de leurs extremites (y compris celles deja fermees),
+    // trames recues d'un pair non negocie ou illisibles (groupes mal formes compris)
+    uint64_t reliablePeers = 0;
+    ReliableStats reliable;
+    uint64_t rejectedFrames = 0;
+
+    // batchFill[i] : lots de taille [2^i, 2^(i+1)[ (le dernier seau cumule le reste)
+    uint64_t batchFill[BatchHistogramSize] = {};
+};
+
 
 class NetworkServer
 {
@@ -21,23 +111,75 @@ public:
     NetworkServer();
     ~NetworkServer();
 
-    bool Start(unsigned short port);
+    bool Start(unsigned short port, const NetworkServerConfig& config = {});
     void Stop();
 
+    NetworkStats GetStats() const;
+    int GetReceiveWorkerCount() const { return static_cast<int>(m_shards.size()); }
+    bool IsUsingIoUring() const { return m_uring != nullptr; }
+
+    // Les envois sont mis en file (thread de jeu uniquement) et partent au FlushSends() de fin de tick.
+    // Un paquet d'un canal fiable vers un pair negocie part en trame fiable ; sinon datagramme brut.
     void SendTo(const GamePacket& packet, const sockaddr_in& address);
-    void SendTo(const IPacket& packet, const sockaddr_in& address);
+    void SendTo(const IPacket& packet, const sockaddr_in& address, WireFormat format = WireFormat::Legacy);
+    void SendTo(const EncodedPacket& packet, const sockaddr_in& address, ReliableChannel channel = ReliableChannel::None);
+    void FlushSends();
+
+    // Paquet concret : encode sans vtable, directement dans l'entree de la file
+    template <StaticPacket PacketT>
+    void SendTo(const PacketT& packet, const sockaddr_in& address, WireFormat format = WireFormat::Legacy)
+    {
+        if constexpr (PacketT::Channel != ReliableChannel::None)
+        {
+            if (ReliablePeer* peer = FindReliable(address))
+            {
+                GamePacket payload;
+                packet.Encode(payload, format);
+                SendReliable(*peer, PacketT::Channel, payload);
+                return;
+            }
+        }
+
+        if (GamePacket* out = QueueSend(address))
+            packet.Encode(*out, format);
+    }
+
+    // Fiabilite par pair (negociee au login). Open repart d'une extremite neuve et l'annonce au pair.
+    void OpenReliable(const sockaddr_in& address);
+    void CloseReliable(const sockaddr_in& address);
+    bool IsReliable(const sockaddr_in& address) const;
+
+    // Datagrammes groupes vers ce pair (negocie au login), paquets seuls sinon
+    void SetBundling(const sockaddr_in& address, bool enabled);
+    bool IsBundling(const sockaddr_in& address) const;
+
+    // Paquets de plus de SAFE_DATAGRAM_SIZE decoupes en fragments vers ce pair (negocie au login).
+    // Sinon ils partent tels quels, comme avant.
+    void SetFragmentation(const sockaddr_in& address, bool enabled);
+    bool IsFragmenting(const sockaddr_in& address) const;
+
+    // Prochaine retransmission due (time_point::max() si aucune)
+    std::chrono::steady_clock::time_point NextReliableDeadline() const;
     void PollEvents();
 
-    using PacketHandler = std::function<void(GamePacket&, const sockaddr_in&)>;
+    // Bloque le thread de jeu jusqu'a l'arrivee d'un paquet ou jusqu'a deadline.
+    // Les threads de reception le reveillent (eventfd) uniquement s'il dort.
+    void WaitForPackets(std::chrono::steady_clock::time_point deadline);
+
+    // N'importe quel thread : le prochain WaitForPackets (ou celui en cours) rend la main aussitot.
+    // Pour du travail produit hors du thread de jeu (salles de jeu sur leurs workers).
+    void Wakeup();
+
+    using Dispatcher = PacketDispatcher<const sockaddr_in&>;
+    using PacketHandler = Dispatcher::Handler;
     void OnPacket(OpCode type, PacketHandler handler);
 
-private:
-    void ReceiveLoop();
+    // Handler type : fn(PacketT&, const sockaddr_in& sender), paquet deja decode
+    template <typename PacketT, typename Fn>
+    void OnPacket(Fn handler) { m_dispatcher.On<PacketT>(std::move(handler)); }
 
-    SOCKET m_socket;
-    sockaddr_in m_serverAddr;
-    std::atomic<bool> m_isRunning;
-    std::thread m_receiveThread;
+private:
+    struct ReceiveBatch;
 
     struct ReceivedPacket
     {
@@ -45,7 +187,134 @@ private:
         sockaddr_in sender;
     };
 
-    std::mutex m_mutex;
-    std::queue<ReceivedPacket> m_packetQueue;
-    std::map<OpCode, PacketHandler> m_handlers;
+    // Un worker de reception : socket, boucle d'evenements, tampons et file propres
+    struct ReceiveShard
+    {
+        explicit ReceiveShard(size_t queueCapacity);
+        ~ReceiveShard();
+
+        SOCKET socket = INVALID_SOCKET;
+        EventLoop eventLoop;
+        std::thread thread;
+        std::unique_ptr<ReceiveBatch> batch;
+        std::unique_ptr<RateLimiter> limiter;
+
+        // Producteur : le thread du shard. Consommateur : le thread de jeu (PollEvents), qui releve
+        // les files des shards a tour de role : pas de CAS partage entre shards, et l'ordre d'un
+        // expediteur (toujours le meme shard) est garde sans effort.
+        SpscRing<ReceivedPacket> packetQueue;
+    };
+
+    // Envoi en attente : soit un tampon propre (issu du pool), soit un paquet pre-encode partage
+    struct OutboundPacket
+    {
+        GamePacket owned;
+        EncodedPacket shared;
+        sockaddr_in address;
+
+        const GamePacket& Bytes() const { return shared ? *shared : owned; }
+    };
+
+    struct SendBatch;
+
+    struct ReliablePeer
+    {
+        sockaddr_in address = {};
+        ReliableEndpoint endpoint;
+
+        // Envoi, trame recue ou ouverture depuis le dernier Service() : sinon rien avant l'echeance
+        bool touched = true;
+    };
+
+    // Nouvelle entree d'envoi a remplir (nullptr si le serveur est arrete)
+    GamePacket* QueueSend(const sockaddr_in& address);
+
+    static uint64_t PeerKey(const sockaddr_in& address);
+    ReliablePeer* FindReliable(const sockaddr_in& address);
+    void SendReliable(ReliablePeer& peer, ReliableChannel channel, const GamePacket& payload);
+    void ReceiveReliable(ReceivedPacket& packet);
+    void ServiceReliable();
+
+    // Remplace dans m_outbound chaque paquet trop gros vers un pair qui reassemble par ses fragments
+    void FragmentSends();
+
+    // Compacte m_outbound en place : l'ordre des paquets d'un meme pair est conserve
+    void CoalesceSends();
+    bool AppendToBundle(OutboundPacket& head, const GamePacket& bytes);
+
+    bool StartIoUring();
+    bool OpenShard(ReceiveShard& shard, bool reusePort);
+    void CloseShards();
+
+    void ReceiveLoop(ReceiveShard& shard);
+    void DrainSocket(ReceiveShard& shard);
+    int ReceiveBatchFrom(ReceiveShard& shard);
+    void RecordBatch(int count, int batchSize);
+    bool AllowPacket(RateLimiter& limiter, const char* data, int size, const sockaddr_in& sender);
+    bool AllowSingle(RateLimiter& limiter, const char* data, int size, const sockaddr_in& sender);
+    void DispatchPacket(ReceivedPacket& packet);
+    bool HasPendingPackets() const;
+    void NotifyGameThread();
+
+    NetworkServerConfig m_config;
+    std::vector<std::unique_ptr<ReceiveShard>> m_shards;
+
+    // Socket d'emission (celui du premier shard : tous partagent le meme port)
+    SOCKET m_socket;
+    sockaddr_in m_serverAddr;
+    std::atomic<bool> m_isRunning;
+
+    Dispatcher m_dispatcher;
+
+    // Backend io_uring : les datagrammes recus sont accumules puis distribues par PollEvents
+    std::unique_ptr<IoUringBackend> m_uring;
+    std::unique_ptr<RateLimiter> m_uringLimiter;
+    IoUringBackend::ReceiveHandler m_uringHandler;
+    std::vector<ReceivedPacket> m_uringReceived;
+    std::vector<ReceivedPacket> m_uringDispatch;
+    int m_uringReaped = 0;   // datagrammes recus depuis le dernier PollEvents (y compris pendant FlushSends)
+
+    // Reveil du thread de jeu. m_wakeRequested : un Wakeup() pas encore vu par WaitForPackets
+    EventLoop m_gameWakeup;
+    std::atomic<bool> m_gameWaiting{ false };
+    std::atomic<bool> m_wakeRequested{ false };
+
+    std::vector<OutboundPacket> m_outbound;
+    std::unique_ptr<SendBatch> m_sendBatch;
+
+    // Thread de jeu uniquement. Les paquets livres par une trame sont distribues apres Receive :
+    // un handler peut fermer l'extremite qui les a livres (kick).
+    std::unordered_map<uint64_t, std::unique_ptr<ReliablePeer>> m_reliablePeers;
+    std::vector<GamePacket> m_reliableDelivered;
+
+    // Pairs non inactifs (IsIdle faux) : les seuls que ServiceReliable et NextReliableDeadline parcourent.
+    // Ajoutes par un envoi ou une trame recue, retires une fois inactifs.
+    std::unordered_set<ReliablePeer*> m_activeReliable;
+    ReliableStats m_closedReliableStats;
+    uint64_t m_rejectedFrames = 0;
+
+    // Thread de jeu uniquement. m_openBundles : pair -> entree de m_outbound qui accueille ses paquets
+    std::unordered_set<uint64_t> m_bundlePeers;
+    std::unordered_map<uint64_t, size_t> m_openBundles;
+    uint64_t m_bundles = 0;
+    uint64_t m_bundledPackets = 0;
+
+    // Thread de jeu uniquement. Pair -> prochain numero de message fragmente
+    std::unordered_map<uint64_t, uint16_t> m_fragmentPeers;
+    std::vector<OutboundPacket> m_fragmented;
+    uint64_t m_fragmentedPackets = 0;
+    uint64_t m_fragments = 0;
+    uint64_t m_oversizedPackets = 0;
+
+    std::atomic<uint64_t> m_receiveBatches{ 0 };
+    std::atomic<uint64_t> m_receivedDatagrams{ 0 };
+    std::atomic<uint64_t> m_fullBatches{ 0 };
+    std::atomic<uint64_t> m_queueDrops{ 0 };
+    std::atomic<uint64_t> m_truncatedDatagrams{ 0 };
+    std::atomic<uint64_t> m_rateLimited[RateLimitConfig::BucketCount] = {};
+
+    uint64_t m_sendBatches = 0;
+    uint64_t m_sentDatagrams = 0;
+    uint64_t m_sendErrors = 0;
+    std::atomic<uint64_t> m_batchFill[NetworkStats::BatchHistogramSize] = {};
 };
@@ -0,0 +1,54 @@
+#pragma once
+#include "SocketPlatform.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+
+
+// ==== Boucle d'evenements non bloquante ====
+// epoll + eventfd sous Linux, poll/WSAPoll + socket de reveil loopback ailleurs.
+// Un seul thread appelle Wait(), Wakeup() peut etre appele depuis n'importe quel thread.
+class EventLoop
+{
+public:
+    struct Event
+    {
+        SOCKET socket = INVALID_SOCKET;
+        void* userData = nullptr;
+    };
+
+    EventLoop();
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    bool Open();
+    void Close();
+
+    // Surveille la lisibilite d'un socket (doit etre non bloquant)
+    bool Watch(SOCKET socket, void* userData = nullptr);
+    void Unwatch(SOCKET socket);
+
+    // Bloque jusqu'a un evenement, un Wakeup() ou timeoutMs (-1 = infini).
+    // Retourne le nombre de sockets prets ecrits dans events.
+    int Wait(Event* events, int maxEvents, int timeoutMs);
+    void Wakeup();
+
+private:
+    void DrainWakeup();
+
+#ifdef __linux__
+    int m_epollFd;
+    int m_wakeupFd;
+
+    // epoll_event::data.ptr pointe sur ces entrees
+    std::vector<std::unique_ptr<Event>> m_registered;
+#else
+    SOCKET m_wakeupSocket;
+    sockaddr_in m_wakeupAddr;
+
+    std::mutex m_watchMutex;
+    std::vector<Event> m_watched;
+#endif
+};
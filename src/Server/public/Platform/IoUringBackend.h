@@ -0,0 +1,61 @@
+#pragma once
+#include "SocketPlatform.h"
+#include <functional>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+
+// ==== Backend io_uring (Linux >= 5.11) ====
+// Un recvmsg multishot reste poste en permanence et pioche dans un anneau de tampons fournis
+// (provided buffer ring, noyau >= 6.0). A defaut, receiveSlots RECVMSG simples restent postes,
+// chacun sur son propre tampon. Les envois partent en lots de SENDMSG.
+// Le thread de jeu pilote tout depuis la file de completion : pas de thread de reception.
+// Open() echoue proprement (noyau trop ancien, io_uring desactive, hors Linux) :
+// l'appelant retombe alors sur le backend a threads.
+class IoUringBackend
+{
+public:
+    using ReceiveHandler = std::function<void(const char* data, int size, const sockaddr_in& sender)>;
+
+    IoUringBackend();
+    ~IoUringBackend();
+
+    IoUringBackend(const IoUringBackend&) = delete;
+    IoUringBackend& operator=(const IoUringBackend&) = delete;
+
+    bool Open(SOCKET socket, unsigned queueDepth = 256, unsigned receiveSlots = 64);
+    void Close();
+    bool IsOpen() const { return m_ring != nullptr; }
+    bool IsMultishot() const;
+
+    // Traite les completions disponibles sans bloquer. Retourne le nombre de datagrammes recus.
+    int ProcessCompletions(const ReceiveHandler& handler);
+
+    // Les donnees doivent rester valides jusqu'au retour de SubmitSends().
+    // Retourne false quand tous les emplacements d'envoi sont pris : appeler SubmitSends() d'abord.
+    bool QueueSend(const char* data, int size, const sockaddr_in& address);
+
+    // Soumet les envois en attente et attend leurs completions (les receptions arrivees
+    // entre-temps passent par handler). Un envoi refuse sur -EAGAIN est resoumis des que le
+    // tampon d'envoi a de la place, au plus waitMs d'attente. Retourne le nombre d'envois en erreur.
+    int SubmitSends(const ReceiveHandler& handler, int waitMs);
+
+    // Bloque jusqu'a une completion, un Wakeup() ou timeoutMs
+    void Wait(int timeoutMs);
+
+    // N'importe quel thread, tant que le backend est ouvert : fait revenir Wait() (completion eventfd)
+    void Wakeup();
+
+    uint64_t GetSendSubmits() const { return m_sendSubmits; }
+
+    // Datagrammes tronques (MSG_TRUNC) abandonnes depuis le dernier appel
+    uint64_t TakeTruncatedDatagrams() { return std::exchange(m_truncatedDatagrams, 0); }
+
+private:
+    struct Ring;
+
+    std::unique_ptr<Ring> m_ring;
+    uint64_t m_sendSubmits = 0;
+    uint64_t m_truncatedDatagrams = 0;
+};
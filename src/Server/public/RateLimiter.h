@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+
+#include "PacketSystem.h"
+
+
+// Seau a jetons : perSecond jetons par seconde, au plus burst en reserve. perSecond <= 0 = illimite.
+struct RateLimit
+{
+    float perSecond = 0.0f;
+    float burst = 0.0f;
+};
+
+
+struct RateLimitConfig
+{
+    // Un seau par OpCode 0..13 ; le dernier seau est partage par les OpCodes au-dela
+    // et les paquets trop courts pour en porter un.
+    static constexpr int BucketCount = 15;
+    static constexpr int FallbackBucket = BucketCount - 1;
+
+    bool enabled = true;
+
+    // Adresses suivies par worker de reception (arrondi a la puissance de 2)
+    int trackedSources = 4096;
+
+    RateLimit limits[BucketCount];
+
+    RateLimitConfig();
+
+    RateLimit& For(OpCode type) { return limits[BucketOf(static_cast<int>(type))]; }
+
+    static int BucketOf(int opcode)
+    {
+        return opcode >= 0 && opcode < FallbackBucket ? opcode : FallbackBucket;
+    }
+};
+
+
+// ==== Limiteur de debit par adresse source ====
+// Table a adressage ouvert (sondage lineaire sur une fenetre courte), cles et seaux separes :
+// le sondage ne parcourt que des cles de 8 octets, puis une seule ligne de cache de seaux.
+// Table pleine : l'entree la plus ancienne de la fenetre est recyclee (la source repart a plein).
+// Un limiteur par thread de reception, sans verrou : SO_REUSEPORT garde une source sur un shard.
+class RateLimiter
+{
+public:
+    explicit RateLimiter(const RateLimitConfig& config);
+
+    // true si le paquet passe ; sinon il est a abandonner (un jeton consomme s'il passe)
+    bool Allow(const sockaddr_in& source, int opcode);
+
+private:
+    static constexpr int ProbeWindow = 8;
+    static constexpr uint64_t EmptyKey = 0;
+
+    // Une ligne de cache : horodatage de la derniere recharge + un seau par OpCode
+    struct alignas(64) Entry
+    {
+        uint32_t stampMs = 0;
+        float tokens[RateLimitConfig::BucketCount] = {};
+    };
+
+    static uint64_t MakeKey(const sockaddr_in& source)
+    {
+        // Jamais nul (EmptyKey) : l'adresse 0.0.0.0:0 n'envoie rien
+        return (static_cast<uint64_t>(source.sin_addr.s_addr) << 16) | source.sin_port | (uint64_t(1) << 63);
+    }
+
+    uint32_t NowMs() const;
+    void Reset(Entry& entry, uint32_t now);
+    void Refill(Entry& entry, uint32_t now);
+
+    RateLimitConfig m_config;
+    std::chrono::steady_clock::time_point m_origin;
+
+    size_t m_mask = 0;
+    int m_shift = 0;
+    std::vector<uint64_t> m_keys;
+    std::unique_ptr<Entry[]> m_entries;
+};
@@ -1,13 +1,25 @@
 #pragma once
 #include "IServerSystem.h"
+#include "Core/PlayerRegistry.h"
 
 
 class AuthenticationSystem : public IServerSystem
 {
 public:
     void Init(GameServer* server) override;
-    void Update(float dt) override;
+    void OnPlayerDisconnect(PlayerInfo* player) override;
 
 private:
+    // Un minuteur par joueur, arme sur lastPacketTime + delai. Les paquets ne touchent pas
+    // la roue : a l'expiration, un joueur actif entre-temps est simplement re-arme.
+    void ArmTimeout(PlayerInfo& player);
+    void OnTimeout(PlayerHandle handle);
+
+    // Roster complet (clients compacts), en datagrammes d'au plus SAFE_DATAGRAM_SIZE octets
+    void SendRosterSnapshot(const PlayerInfo& target);
+
+    // Ids des canaux du joueur (clients compacts) : un PacketChannelInfo par canal
+    void SendChannelTable(const PlayerInfo& target);
+
     GameServer* server = nullptr;
 };
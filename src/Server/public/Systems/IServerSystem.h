@@ -1,4 +1,5 @@
 #pragma once
+#include <chrono>
 
 class GameServer;
 struct PlayerInfo;
@@ -11,5 +12,12 @@ public:
 
     virtual void Init(GameServer* server) = 0;
     virtual void Update(float dt) {}
+
+    // Fin de login (nouveau joueur ou nouveau login du meme), apres ses canaux et son roster
+    virtual void OnPlayerConnect(PlayerInfo* player) {}
     virtual void OnPlayerDisconnect(PlayerInfo* player) {}
+
+    // Prochain instant ou Update() a du travail. La boucle serveur dort jusque-la si aucun
+    // paquet n'arrive avant. Pour des echeances ponctuelles, preferer GameServer::GetTimers().
+    virtual std::chrono::steady_clock::time_point GetNextDeadline() const { return std::chrono::steady_clock::time_point::max(); }
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "IServerSystem.h"
+#include "Core/MatchQueue.h"
+#include "Core/PlayerRegistry.h"
+
+class MiniGameSystem;
+
+
+// ==== Matchmaking ====
+// /queue [region] : file d'attente par region et par classement (MatchQueue). A chaque tick, les
+// groupes formes recoivent une salle a eux (MiniGameSystem::OpenMatch), manche lancee.
+// Classement Elo par pseudo, pour la vie du serveur : seule la premiere manche d'une salle
+// formee compte, entre les seuls joueurs du groupe forme (le gagnant affronte chacun des autres).
+// Entrer dans la salle en cours de manche ne rapporte rien ; la quitter ne protege pas d'une defaite.
+class MatchmakingSystem : public IServerSystem
+{
+public:
+    static constexpr int InitialRating = 1000;
+    static constexpr int RatingFactor = 32;   // K
+    static constexpr const char* DefaultRegion = "any";
+
+    MatchmakingSystem(MiniGameSystem* games, const MatchmakingConfig& config = {});
+
+    void Init(GameServer* server) override;
+    void Update(float dt) override;
+    void OnPlayerDisconnect(PlayerInfo* player) override;
+    std::chrono::steady_clock::time_point GetNextDeadline() const override;
+
+    int GetRating(const std::string& pseudo) const;
+
+private:
+    void OnQueue(PlayerInfo& player, const std::vector<std::string>& args);
+    void OnRoundOver(uint32_t roomId, PlayerHandle winner, const std::vector<PlayerHandle>& players);
+
+    void Reply(const PlayerInfo& player, std::string message);
+
+    GameServer* m_server = nullptr;
+    MiniGameSystem* m_games;
+
+    MatchQueue m_queue;
+    std::vector<MatchGroup> m_groups;   // reutilise d'un tick a l'autre
+    std::vector<PlayerHandle> m_joined;
+
+    std::unordered_map<std::string, int> m_ratings;
+
+    // Salle formee dont la premiere manche n'est pas finie -> joueurs du groupe entres dans la salle
+    std::unordered_map<uint32_t, std::vector<PlayerHandle>> m_rankedRooms;
+};
@@ -0,0 +1,159 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <unordered_map>
+#include <cstdint>
+
+#include "PacketSystem.h"
+#include "Core/PlayerRegistry.h"
+#include "Core/TimerWheel.h"
+
+
+// Copie d'un joueur propre a sa salle : le worker ne lit jamais le PlayerRegistry du thread de jeu
+struct RoomMember
+{
+    PlayerHandle handle;
+    uint16_t id = 0;
+    std::string pseudo;
+    sockaddr_in address = {};
+    WireFormat wireFormat = WireFormat::Legacy;
+    bool isSpectator = false;
+};
+
+
+// Thread de jeu -> worker de la salle
+struct RoomEvent
+{
+    enum class Type : uint8_t
+    {
+        Open,       // channelId, channelName : canal de chat de la salle
+        Close,
+        Join,       // member (remplace la copie existante s'il est deja membre)
+        Leave,      // member.handle
+        Spectate,   // member.handle, value : 1 = spectateur
+        Start,
+        Stop,
+        Guess       // member.handle, value : nombre propose
+    };
+
+    Type type = Type::Join;
+    uint32_t roomId = 0;
+    RoomMember member;
+    int value = 0;
+
+    uint16_t channelId = 0;
+    std::string channelName;
+};
+
+
+// Worker -> thread de jeu
+struct RoomOutput
+{
+    enum class Type : uint8_t
+    {
+        Packet,     // address, packet, channel : deja encode au format du destinataire
+        RoundOver   // roomId, winner (invalide sans gagnant), players : joueurs actifs de la manche
+    };
+
+    Type type = Type::Packet;
+
+    sockaddr_in address = {};
+    EncodedPacket packet;
+    ReliableChannel channel = ReliableChannel::None;
+
+    uint32_t roomId = 0;
+    PlayerHandle winner;
+    std::vector<PlayerHandle> players;
+};
+
+
+// Ce qu'un worker prete a ses salles. Les sorties s'accumulent ici puis passent dans la file du
+// worker vers le thread de jeu : une file pleine ne bloque aucune salle, le reste attend un tour.
+struct RoomContext
+{
+    TimerWheel timers;
+    std::vector<RoomOutput> outputs;
+    std::mt19937 rng{ std::random_device{}() };
+};
+
+
+// ==== Une partie de "nombre mystere" ====
+// Tout son etat (membres, manche, minuteur) vit sur le worker qui la possede : rien n'est partage
+// avec le thread de jeu ni avec les autres salles. Elle ne voit le monde qu'a travers ses
+// RoomEvent et n'y repond que par RoomContext::outputs.
+class MiniGameRoom
+{
+public:
+    static constexpr std::chrono::seconds RoundDuration{ 120 };
+
+    MiniGameRoom(uint32_t id, uint16_t channelId, std::string channelName, RoomContext& context);
+    ~MiniGameRoom();
+
+    MiniGameRoom(const MiniGameRoom&) = delete;
+    MiniGameRoom& operator=(const MiniGameRoom&) = delete;
+
+    void Handle(RoomEvent& event);
+
+    uint32_t GetId() const { return m_id; }
+    size_t GetMemberCount() const { return m_members.size(); }
+    bool IsRunning() const { return m_gameRunning; }
+
+private:
+    void Join(RoomMember&& member);
+    void Leave(PlayerHandle handle);
+    RoomMember* FindMember(PlayerHandle handle);
+
+    void StartRound();
+
+    // Arrete la manche en cours et publie son issue (RoundOver)
+    void EndRound(const RoomMember* winner = nullptr);
+    void OnRoundTimeout();
+    void OnGuess(PlayerHandle handle, int guess);
+
+    // Fin de manche si plus aucun joueur actif
+    void CheckActivePlayers();
+
+    template <StaticPacket PacketT>
+    void SendTo(const RoomMember& member, const PacketT& pkt)
+    {
+        Push(member, EncodePacket(pkt, member.wireFormat), PacketT::Channel);
+    }
+
+    // Encode une fois par format present, comme GameServer::Broadcast
+    template <StaticPacket PacketT>
+    void Broadcast(const PacketT& pkt)
+    {
+        EncodedPacket encoded[WireFormatCount];
+        for (const RoomMember& member : m_members)
+        {
+            EncodedPacket& bytes = encoded[static_cast<int>(member.wireFormat)];
+            if (!bytes)
+                bytes = EncodePacket(pkt, member.wireFormat);
+
+            Push(member, bytes, PacketT::Channel);
+        }
+    }
+
+    void Push(const RoomMember& member, const EncodedPacket& bytes, ReliableChannel channel);
+
+    // Message systeme dans le canal de la salle
+    void Announce(std::string message);
+
+    uint32_t m_id;
+    uint16_t m_channelId;
+    std::string m_channelName;
+    RoomContext& m_context;
+
+    // Tableau dense ; m_memberIndex : handle.index -> position
+    std::vector<RoomMember> m_members;
+    std::unordered_map<uint32_t, size_t> m_memberIndex;
+
+    bool m_gameRunning = false;
+    int m_mysteryNumber = 0;
+    TimerHandle m_roundTimer;
+
+    std::mt19937 m_rng;
+    std::uniform_int_distribution<int> m_dist{ 0, 99 };
+};
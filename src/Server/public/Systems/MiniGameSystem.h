@@ -1,18 +1,73 @@
 #pragma once
-#include <random>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
 #include "IServerSystem.h"
+#include "Systems/RoomPool.h"
 
 
+// ==== Salles de jeu, cote thread de jeu ====
+// Les parties tournent dans des MiniGameRoom reparties sur les workers d'un RoomPool. Ce systeme
+// ne garde que l'annuaire (salle -> canal, effectif) et la salle de chaque joueur
+// (PlayerInfo::roomId) : il route les paquets de jeu vers la file de la salle et envoie
+// les sorties des workers a chaque tick.
+// Le lobby (LobbyRoomId) est la salle de tous au login, avec le canal "Game" comme canal de salle.
+// Les autres salles ont un canal reserve "Salle#<id>" et ferment avec leur dernier membre.
 class MiniGameSystem : public IServerSystem
 {
 public:
-    MiniGameSystem();
+    static constexpr uint32_t LobbyRoomId = 1;
+
+    // Fin de manche d'une salle (thread de jeu) : gagnant (handle invalide sans gagnant), joueurs actifs
+    using RoundOverHandler = std::function<void(uint32_t roomId, PlayerHandle winner, const std::vector<PlayerHandle>& players)>;
+
+    // workerCount <= 0 : la moitie des coeurs, au moins un
+    explicit MiniGameSystem(int workerCount = 0);
+    ~MiniGameSystem() override;
+
     void Init(GameServer* server) override;
+    void Update(float dt) override;
+    void OnPlayerConnect(PlayerInfo* player) override;
+    void OnPlayerDisconnect(PlayerInfo* player) override;
+
+    void OnRoundOver(RoundOverHandler handler) { m_roundOverHandlers.push_back(std::move(handler)); }
+
+    // Nouvelle salle pour ces joueurs (quittent leur salle courante), manche lancee aussitot.
+    // 'joined' recoit ceux qui y sont entres (canal refuse, deconnecte : absents, deja prevenus).
+    // Retourne l'id de la salle, 0 si aucun joueur n'a pu y entrer.
+    uint32_t OpenMatch(const std::vector<PlayerHandle>& players, std::vector<PlayerHandle>& joined);
 
 private:
-    bool m_gameRunning;
-    int m_mysteryNumber;
-    
-    std::mt19937 m_rng;
-    std::uniform_int_distribution<int> m_dist;
+    struct RoomInfo
+    {
+        uint32_t id = 0;
+        uint16_t channelId = 0;
+        std::string channelName;
+        size_t memberCount = 0;
+    };
+
+    // Nouvelle salle dont 'player' est le premier membre (nullptr si son canal est refuse)
+    RoomInfo* CreateRoom(PlayerInfo& player);
+
+    // Quitte la salle courante pour 'room'. false (et message au joueur) si son canal est refuse.
+    bool MoveToRoom(PlayerInfo& player, RoomInfo& room);
+    void LeaveRoom(PlayerInfo& player);
+    bool JoinRoomChannel(PlayerInfo& player, const RoomInfo& room);
+
+    void Post(const PlayerInfo& player, RoomEvent::Type type, int value = 0);
+    void Reply(const PlayerInfo& player, std::string message);
+    static RoomMember MakeMember(const PlayerInfo& player);
+
+    GameServer* m_server = nullptr;
+    int m_workerCount;
+    std::unique_ptr<RoomPool> m_pool;
+
+    std::unordered_map<uint32_t, RoomInfo> m_rooms;
+    uint32_t m_nextRoomId = LobbyRoomId + 1;
+
+    std::vector<RoundOverHandler> m_roundOverHandlers;
 };
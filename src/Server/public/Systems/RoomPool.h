@@ -0,0 +1,105 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
+#include "RingBuffer.h"
+#include "Platform/EventLoop.h"
+#include "Systems/MiniGameRoom.h"
+
+
+// ==== Salles de jeu reparties sur des workers ====
+// Chaque worker possede ses salles, sa roue de minuteurs et deux files SPSC : evenements
+// (thread de jeu -> worker) et sorties (worker -> thread de jeu). Rien d'autre n'est partage :
+// une salle chargee ne retarde que les salles de son worker, et le debit suit le nombre de coeurs.
+// Thread de jeu : Open/Close/Post pendant le tick, puis Flush (reveil des workers concernes)
+// et Drain (sorties a envoyer). Les workers appellent notify() quand ils publient des sorties.
+class RoomPool
+{
+public:
+    using NotifyFn = std::function<void()>;
+
+    // Les evenements de controle (Open, Close, Join, Leave, Spectate) ne sont jamais perdus :
+    // file pleine, ils attendent cote thread de jeu. Start, Stop et Guess sont abandonnes et comptes.
+    RoomPool(int workerCount, NotifyFn notify, size_t queueCapacity = 8192);
+    ~RoomPool();
+
+    RoomPool(const RoomPool&) = delete;
+    RoomPool& operator=(const RoomPool&) = delete;
+
+    int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
+    size_t GetRoomCount() const { return m_roomWorkers.size(); }
+    uint64_t GetDroppedEvents() const { return m_droppedEvents; }
+
+    // Thread de jeu uniquement. La salle va au worker qui en a le moins.
+    bool Open(uint32_t roomId, uint16_t channelId, const std::string& channelName);
+    void Close(uint32_t roomId);
+
+    // false si la salle est inconnue ou l'evenement abandonne
+    bool Post(RoomEvent&& event);
+
+    // Fin de tick : reveille les workers qui ont recu des evenements
+    void Flush();
+
+    // fn(RoomOutput&) pour chaque sortie publiee. Retourne le nombre de sorties.
+    template <typename Fn>
+    size_t Drain(Fn&& fn)
+    {
+        size_t count = 0;
+        RoomOutput output;
+        for (auto& worker : m_workers)
+        {
+            while (worker->outbox.TryPop(output))
+            {
+                fn(output);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+private:
+    struct Worker
+    {
+        explicit Worker(size_t queueCapacity) : inbox(queueCapacity), outbox(queueCapacity) {}
+
+        std::thread thread;
+        EventLoop eventLoop;
+        std::atomic<bool> waiting{ false };
+
+        // Producteur : thread de jeu. Consommateur : le worker.
+        SpscRing<RoomEvent> inbox;
+
+        // Producteur : le worker. Consommateur : thread de jeu (Drain).
+        SpscRing<RoomOutput> outbox;
+
+        // Thread de jeu uniquement
+        std::vector<RoomEvent> backlog;
+        size_t roomCount = 0;
+        bool posted = false;
+
+        // Worker uniquement. Les salles, declarees apres leur contexte, sont detruites avant lui.
+        RoomContext context;
+        std::unordered_map<uint32_t, std::unique_ptr<MiniGameRoom>> rooms;
+    };
+
+    bool PostTo(Worker& worker, RoomEvent&& event);
+    void Wake(Worker& worker);
+
+    void WorkerLoop(Worker& worker);
+    void Dispatch(Worker& worker, RoomEvent& event);
+    bool Publish(Worker& worker);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_isRunning{ true };
+    NotifyFn m_notify;
+
+    // Thread de jeu uniquement : salle -> index de son worker
+    std::unordered_map<uint32_t, size_t> m_roomWorkers;
+    uint64_t m_droppedEvents = 0;
+};
@@ -16,6 +16,8 @@ target("CommonNet")
     
     if is_plat("windows", "mingw") then
         add_syslinks("ws2_32", {public = true}) 
+    else
+        add_syslinks("pthread", {public = true})
     end
 
 -- Le Serveur
@@ -48,4 +50,16 @@ target("Client")
         os.cp("resources/*", dest_dir)
     end)
 
-    add_installfiles("resources/**", {prefixdir = "assets"})
\ No newline at end of file
+    add_installfiles("resources/**", {prefixdir = "assets"})
+
+-- Micro-benchmarks (xmake build Bench && xmake run Bench [filtre])
+target("Bench")
+    set_kind("binary")
+    set_default(false)
+    add_deps("CommonNet")
+    add_files("src/Bench/**.cpp")
+    add_headerfiles("src/Bench/**.h")
+
+    -- Code serveur mesure (sans ServerMain.cpp)
+    add_files("src/Server/private/**.cpp")
+    add_includedirs("src/Server/public")